@@ -0,0 +1,210 @@
+#include "AutoPlayer.h"
+#include <algorithm>
+#include <cmath>
+
+// Fold a position moving freely along a line back into [0, range], as if it bounced off both ends
+static float reflect(float x, float range) {
+    if (range <= 0) return 0;
+    float u = std::fmod(x, 2 * range);
+    if (u < 0) u += 2 * range;
+    return u <= range ? u : 2 * range - u;
+}
+
+bool predictLanding(const GameSim& sim, const Ball& ball, BallLanding& landing) {
+    float lineY = sim.paddle().y - BALL_SIZE;
+    if (ball.rect.y > lineY) return false;
+
+    // an upward ball comes down again from the top wall
+    float time;
+    if (ball.vy > 0) time = (lineY - ball.rect.y) / ball.vy;
+    else if (ball.vy < 0) time = (ball.rect.y + lineY) / -ball.vy;
+    else return false;
+
+    landing.time = time;
+    landing.x = reflect(ball.rect.x + ball.vx * time, sim.fieldWidth() - BALL_SIZE) + BALL_SIZE / 2;
+    return true;
+}
+
+// Lowest standing brick nearest to x (the easiest one to reach), false when none are left
+static bool pickBrick(const GameSim& sim, float x, SDL_FRect& brick) {
+    const BrickField& bricks = sim.bricks();
+    int best = -1;
+    float bestBottom = 0, bestDistance = 0;
+    for (int i = 0; i < bricks.size(); ++i) {
+        if (!bricks.alive(i)) continue;
+        const SDL_FRect& r = bricks.rect(i);
+        float bottom = r.y + r.h;
+        float distance = std::abs(r.x + r.w / 2 - x);
+        if (best < 0 || bottom > bestBottom || (bottom == bestBottom && distance < bestDistance)) {
+            best = i;
+            bestBottom = bottom;
+            bestDistance = distance;
+        }
+    }
+    if (best < 0) return false;
+    brick = bricks.rect(best);
+    return true;
+}
+
+// Where to hold a ball on the sticky paddle so it heads for a brick once let go.
+// A released ball keeps the angle it was caught at, so only where it starts from
+// can be chosen. Returns false when no spot in reach sends it at a brick.
+static bool releaseX(const GameSim& sim, const Ball& ball, float& centerX) {
+    const SDL_FRect& paddle = sim.paddle();
+    float center = ball.rect.x + BALL_SIZE / 2;
+    SDL_FRect brick;
+    if (ball.vy == 0 || !pickBrick(sim, center, brick)) return false;
+
+    // sideways travel on the way up, and the ball centers the paddle can carry it to
+    float rise = ball.rect.y - (brick.y + brick.h);
+    if (rise <= 0) return false;
+    float drift = ball.vx * rise / std::abs(ball.vy);
+    float range = sim.fieldWidth() - BALL_SIZE;
+    float offset = center - paddle.x;
+    float lo = offset, hi = sim.fieldWidth() - paddle.w + offset;
+
+    // straight there, or by way of either side wall
+    float goal = brick.x + brick.w / 2 - BALL_SIZE / 2;
+    const float starts[3] = { goal - drift, -goal - drift, 2 * range - goal - drift };
+    bool found = false;
+    for (float start : starts) {
+        float x = start + BALL_SIZE / 2;
+        if (start < 0 || start > range || x < lo || x > hi) continue;
+        if (!found || std::abs(x - center) < std::abs(centerX - center)) centerX = x;
+        found = true;
+    }
+    return found;
+}
+
+void AutoPlayer::reset(uint64_t seed, const AutoPlayerSkill& newSkill) {
+    skill = newSkill;
+    rng.seed(seed, RngStream::AUTOPLAY);
+    int steps = std::max(0, (int)std::lround(skill.reactionTime / FIXED_DT));
+    delayed.assign(steps, Aim{ false, 0 });
+    head = 0;
+    error = 0;
+    errorDrawn = false;
+    stallHitPos = 0;
+    sinceBroken = 0;
+    holding = false;
+}
+
+AutoPlayer::Aim AutoPlayer::chooseAim(const GameSim& sim) {
+    const SDL_FRect& paddle = sim.paddle();
+    float paddleX = paddle.x + paddle.w / 2;
+
+    // earliest landing the paddle can get to in time, else simply the earliest.
+    // Rising balls only count when nothing is falling: bricks will turn them
+    // around long before the top wall does, so their landing is a poor guess.
+    const Ball* best = nullptr;
+    const Ball* earliest = nullptr;
+    BallLanding bestLanding = { 0, 0 }, earliestLanding = { 0, 0 };
+    for (int pass = 0; pass < 2 && !earliest; ++pass) {
+        bool falling = pass == 0;
+        for (const Ball& b : sim.balls()) {
+            BallLanding landing;
+            if (!b.active || (b.vy > 0) != falling || !predictLanding(sim, b, landing)) continue;
+            if (!earliest || landing.time < earliestLanding.time) {
+                earliest = &b;
+                earliestLanding = landing;
+            }
+            float travel = std::max(0.0f, std::abs(landing.x - paddleX) - paddle.w / 2);
+            if (travel <= PADDLE_SPEED * landing.time && (!best || landing.time < bestLanding.time)) {
+                best = &b;
+                bestLanding = landing;
+            }
+        }
+    }
+    if (!earliest) return { false, 0 };
+    const Ball& target = best ? *best : *earliest;
+    BallLanding landing = best ? bestLanding : earliestLanding;
+
+    // a new read of the ball every time it turns, good or bad
+    bool vxRight = target.vx > 0, vyDown = target.vy > 0;
+    if (!errorDrawn || vxRight != lastVxRight || vyDown != lastVyDown) {
+        error = (rng.unit() * 2 - 1) * skill.aimError;
+        errorDrawn = true;
+        lastVxRight = vxRight;
+        lastVyDown = vyDown;
+    }
+
+    float aimX;
+    if (target.vy > 0) {
+        // the paddle sends the ball sideways in proportion to how far from its
+        // center it lands, so meet it where the bounce heads for a brick
+        float hitPos = 0;
+        SDL_FRect brick;
+        if (pickBrick(sim, landing.x, brick)) {
+            float rise = paddle.y - (brick.y + brick.h);
+            float dx = brick.x + brick.w / 2 - landing.x;
+            if (rise > 0) hitPos = std::clamp(dx * std::abs(target.vy) / rise / PADDLE_BOUNCE_SPREAD, -0.4f, 0.4f);
+        }
+        hitPos = std::clamp(hitPos + stallHitPos, -0.4f, 0.4f);
+        aimX = landing.x + error - hitPos * paddle.w;
+    }
+    else {
+        // stay under a rising ball until it turns around
+        aimX = target.rect.x + target.rect.w / 2 + error;
+    }
+    return { true, aimX };
+}
+
+InputFrame AutoPlayer::play(const GameSim& sim) {
+    InputFrame input;
+    // launches the ball, releases it from a sticky paddle and fires lasers
+    input.launch = true;
+
+    const SDL_FRect& paddle = sim.paddle();
+    float paddleX = paddle.x + paddle.w / 2;
+    float deadZone = PADDLE_SPEED * FIXED_DT;
+
+    // a ball that bounces around without breaking anything is caught in a loop
+    // that the same paddle hits would keep repeating, so meet it somewhere else
+    sinceBroken += FIXED_DT;
+    for (const SimEvent& e : sim.events()) {
+        if (e.type == SimEventType::BRICK_BROKEN || e.type == SimEventType::NEW_LAYOUT) {
+            sinceBroken = 0;
+            stallHitPos = 0;
+        }
+    }
+    if (skill.stallTime > 0 && sinceBroken >= skill.stallTime) {
+        stallHitPos = (rng.unit() * 2 - 1) * 0.4f;
+        sinceBroken = 0;
+    }
+
+    // act on what was seen reactionTime ago
+    Aim aim = chooseAim(sim);
+    if (!delayed.empty()) {
+        std::swap(aim, delayed[head]);
+        head = (head + 1) % (int)delayed.size();
+    }
+
+    // the sticky paddle never changes a ball's angle, so carry a held ball to where
+    // that angle hits a brick before letting go, unless another ball is falling.
+    // The spot is picked once per catch: the nearest brick changes as the ball moves.
+    int stuck = sim.stuckBallIndex();
+    if (stuck < 0) holding = false;
+    else {
+        const Ball& held = sim.balls()[stuck];
+        if (!holding) {
+            holding = true;
+            carry = releaseX(sim, held, holdX);
+        }
+        bool falling = false;
+        for (int i = 0; i < sim.balls().size(); ++i) {
+            const Ball& b = sim.balls()[i];
+            if (i != stuck && b.active && b.vy > 0) falling = true;
+        }
+        if (carry && !falling) {
+            float heldX = held.rect.x + BALL_SIZE / 2;
+            input.launch = std::abs(holdX - heldX) <= deadZone;
+            aim = { true, paddleX + holdX - heldX };
+        }
+    }
+    if (!aim.valid) return input;
+
+    // one step of paddle travel either side counts as there, so it does not jitter
+    input.left = aim.x < paddleX - deadZone;
+    input.right = aim.x > paddleX + deadZone;
+    return input;
+}
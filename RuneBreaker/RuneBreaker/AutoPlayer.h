@@ -0,0 +1,70 @@
+#pragma once
+#include "GameSim.h"
+#include "Rng.h"
+#include <vector>
+
+// Where and when a ball will come down to the paddle
+struct BallLanding {
+    float time; // seconds until the ball's bottom reaches the top of the paddle
+    float x; // ball center at that moment
+};
+
+// Trace a ball to the paddle line, reflecting it off the side and top walls
+// analytically. Bricks are ignored, so the prediction firms up as the ball
+// gets closer. Returns false for a ball already past the paddle.
+bool predictLanding(const GameSim& sim, const Ball& ball, BallLanding& landing);
+
+// How well the autoplayer plays. The defaults drop a ball now and then, so
+// balance runs see lives lost the way a player would; all zeros plays perfectly.
+struct AutoPlayerSkill {
+    float reactionTime = 0.15f; // seconds before the paddle responds to what it sees
+    float aimError = 45.0f; // most a landing is misjudged by, in pixels (redrawn each bounce)
+    float stallTime = 10.0f; // seconds without a broken brick before the aim is shaken up (0 = never)
+};
+
+// Plays a GameSim like a player would: launch straight away, pick the ball that
+// lands first among those the paddle can still reach, and meet it slightly
+// off-center so it heads towards the remaining bricks. A ball held by the
+// sticky paddle is carried to where its angle hits a brick, and a ball that has
+// broken nothing for a while is met at a new spot to get it out of a loop. The
+// skill's reaction delay and aim error come from the player's own stream of the
+// run seed, so a seed plays out the same every time without touching the
+// game's streams.
+class AutoPlayer {
+public:
+    // Start over for a new game (pass the run seed it was reset with)
+    void reset(uint64_t seed, const AutoPlayerSkill& skill = AutoPlayerSkill());
+
+    // The keys to press this step
+    InputFrame play(const GameSim& sim);
+
+private:
+    // Where the paddle is headed, invalid when there is no ball to chase
+    struct Aim {
+        bool valid;
+        float x;
+    };
+
+    Aim chooseAim(const GameSim& sim);
+
+    AutoPlayerSkill skill;
+    Rng rng;
+
+    // aims chosen over the last reactionTime, the oldest (at head) is the one acted on
+    std::vector<Aim> delayed;
+    int head = 0;
+
+    // misjudgement of the current bounce, redrawn when the target ball turns
+    float error = 0;
+    bool errorDrawn = false;
+    bool lastVxRight = false, lastVyDown = false;
+
+    // extra off-center hit while the ball is caught in a pattern that breaks nothing
+    float stallHitPos = 0;
+    float sinceBroken = 0;
+
+    // where a ball held by the sticky paddle is carried before it is let go
+    bool holding = false;
+    bool carry = false; // false when no spot in reach sends it at a brick
+    float holdX = 0;
+};
@@ -0,0 +1,81 @@
+#include "BrickField.h"
+#include "GameTypes.h"
+#include <algorithm>
+
+SDL_Color getHitColor(int hits, int maxHits) {
+    if (maxHits == 1) return { 120, 80, 200, 255 }; // purple for 1-hit
+    if (hits == maxHits) return { 200, 50, 50, 255 }; // red for full health
+    if (hits == maxHits - 1) return { 200, 120, 50, 255 }; // orange for damaged
+    return { 180, 150, 80, 255 };
+}
+
+void BrickField::reset(int rows, int cols, float brickW) {
+    rects.clear();
+    hitPoints.clear();
+    alives.clear();
+    maxHitPoints.clear();
+    runeTypes.clear();
+    cells.clear();
+    layoutRows = rows;
+    layoutCols = cols;
+    brickWidth = brickW;
+    liveBricks = 0;
+    clock = 0;
+    grid.reset(rows, cols, BRICK_PADDING, BRICK_TOP_OFFSET, brickW + BRICK_PADDING, BRICK_HEIGHT + BRICK_PADDING);
+}
+
+int BrickField::add(int row, int col, const SDL_FRect& rect, int maxHits, int runeType) {
+    int i = size();
+    rects.push_back(rect);
+    hitPoints.push_back(maxHits);
+    alives.push_back(1);
+    maxHitPoints.push_back(maxHits);
+    runeTypes.push_back(runeType);
+    cells.push_back((Uint16)(row * layoutCols + col));
+    liveBricks++;
+    grid.insert(row, col, i);
+    return i;
+}
+
+bool BrickField::hit(int i) {
+    if (!alives[i]) return false;
+    hitPoints[i]--;
+    if (hitPoints[i] > 0) return false;
+    alives[i] = 0;
+    liveBricks--;
+    return true;
+}
+
+// A broken brick keeps the color it had on its last hit point
+SDL_Color BrickField::color(int i) const {
+    return getHitColor(std::max(hitPoints[i], 1), maxHitPoints[i]);
+}
+
+void BrickField::saveState(BrickFieldState& state) const {
+    int n = std::min(size(), MAX_BRICKS);
+    state.rows = layoutRows;
+    state.cols = layoutCols;
+    state.count = n;
+    state.liveBricks = liveBricks;
+    state.brickW = brickWidth;
+    state.clock = clock;
+    for (int i = 0; i < n; ++i) {
+        state.rects[i] = rects[i];
+        state.hitPoints[i] = hitPoints[i];
+        state.alives[i] = alives[i];
+        state.maxHitPoints[i] = (Uint8)maxHitPoints[i];
+        state.runeTypes[i] = (Uint8)runeTypes[i];
+        state.cells[i] = cells[i];
+    }
+}
+
+void BrickField::loadState(const BrickFieldState& state) {
+    reset(state.rows, state.cols, state.brickW);
+    for (int i = 0; i < state.count; ++i) {
+        add(state.cells[i] / state.cols, state.cells[i] % state.cols, state.rects[i], state.maxHitPoints[i], state.runeTypes[i]);
+        hitPoints[i] = state.hitPoints[i];
+        alives[i] = state.alives[i];
+    }
+    liveBricks = state.liveBricks;
+    clock = state.clock;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <vector>
+#include "BrickGrid.h"
+
+// Color coding based on brick health
+SDL_Color getHitColor(int hits, int maxHits);
+
+const int MAX_BRICKS = 128; // largest layout a BrickFieldState holds
+
+// Plain copy of a BrickField for snapshots, no pointers so it copies with memcpy
+struct BrickFieldState {
+    int rows, cols, count, liveBricks;
+    float brickW, clock;
+    SDL_FRect rects[MAX_BRICKS];
+    int hitPoints[MAX_BRICKS];
+    Uint8 alives[MAX_BRICKS];
+    Uint8 maxHitPoints[MAX_BRICKS];
+    Uint8 runeTypes[MAX_BRICKS];
+    Uint16 cells[MAX_BRICKS]; // row * cols + col
+};
+
+// All bricks of the current level, stored as parallel arrays.
+// Collision tests only touch rects, hit points and alive flags, which sit in
+// their own contiguous arrays; the rune and max hit data is only read when
+// drawing. The number of live bricks is kept up to date as bricks break, so
+// level completion is a single compare.
+class BrickField {
+public:
+    // Start an empty rows x cols layout of bricks brickW wide
+    void reset(int rows, int cols, float brickW);
+
+    // Place a brick in a layout cell, returns its index
+    int add(int row, int col, const SDL_FRect& rect, int maxHits, int runeType);
+
+    // Take one hit off a brick, returns true if that broke it
+    bool hit(int i);
+
+    // Advance the clock driving the multi-hit brick glow
+    void advance(float dt) { clock += dt; }
+
+    // Collect indices of bricks near an area (dead bricks included)
+    void query(const SDL_FRect& area, std::vector<int>& out) const { grid.query(area, out); }
+
+    int size() const { return (int)rects.size(); }
+    int aliveCount() const { return liveBricks; }
+    bool alive(int i) const { return alives[i] != 0; }
+    const SDL_FRect& rect(int i) const { return rects[i]; }
+    int hits(int i) const { return hitPoints[i]; }
+    int maxHits(int i) const { return maxHitPoints[i]; }
+    int runeType(int i) const { return runeTypes[i]; }
+    SDL_Color color(int i) const;
+    float glowPhase() const { return clock * 3.0f; }
+
+    // Copy the field into a snapshot, or rebuild it from one
+    void saveState(BrickFieldState& state) const;
+    void loadState(const BrickFieldState& state);
+
+private:
+    // hot - read by every collision test
+    std::vector<SDL_FRect> rects;
+    std::vector<int> hitPoints;
+    std::vector<Uint8> alives;
+    // cold - only needed for drawing
+    std::vector<int> maxHitPoints;
+    std::vector<int> runeTypes; // which rune pattern to display
+    std::vector<Uint16> cells; // layout cell of each brick, to rebuild the grid from a snapshot
+
+    int layoutRows = 0, layoutCols = 0;
+    float brickWidth = 0;
+    int liveBricks = 0;
+    float clock = 0; // seconds since the layout was created
+    BrickGrid grid;
+};
@@ -0,0 +1,40 @@
+#include "BrickGrid.h"
+#include <algorithm>
+#include <cmath>
+
+void BrickGrid::reset(int rows, int cols, float x, float y, float cellW, float cellH) {
+    this->rows = rows;
+    this->cols = cols;
+    originX = x;
+    originY = y;
+    this->cellW = cellW;
+    this->cellH = cellH;
+    cells.assign(rows * cols, -1);
+}
+
+void BrickGrid::insert(int row, int col, int brick) {
+    if (row < 0 || row >= rows || col < 0 || col >= cols) return;
+    cells[row * cols + col] = brick;
+}
+
+void BrickGrid::query(const SDL_FRect& area, std::vector<int>& out) const {
+    out.clear();
+    // the padding after each brick belongs to its cell, so flooring the edges
+    // finds every cell a brick overlapping the area could be in
+    int c0 = (int)std::floor((area.x - originX) / cellW);
+    int c1 = (int)std::floor((area.x + area.w - originX) / cellW);
+    int r0 = (int)std::floor((area.y - originY) / cellH);
+    int r1 = (int)std::floor((area.y + area.h - originY) / cellH);
+    if (c1 < 0 || r1 < 0 || c0 >= cols || r0 >= rows) return;
+
+    c0 = std::max(c0, 0);
+    r0 = std::max(r0, 0);
+    c1 = std::min(c1, cols - 1);
+    r1 = std::min(r1, rows - 1);
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            int brick = cells[r * cols + c];
+            if (brick >= 0) out.push_back(brick);
+        }
+    }
+}
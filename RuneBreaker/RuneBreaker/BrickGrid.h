@@ -0,0 +1,26 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <vector>
+
+// Uniform grid over the brick layout.
+// createBricks places bricks on a regular rows x cols lattice, so each cell
+// holds at most one brick and a position maps to its cell with a divide. A
+// collision query only visits the cells an area overlaps, which keeps the cost
+// per ball or laser constant however many bricks are on the field.
+class BrickGrid {
+public:
+    // Start an empty grid whose top-left cell begins at (x, y), cells spaced cellW x cellH apart
+    void reset(int rows, int cols, float x, float y, float cellW, float cellH);
+
+    // Record the index of the brick occupying a cell
+    void insert(int row, int col, int brick);
+
+    // Collect indices of bricks in the cells overlapping area (dead bricks included)
+    void query(const SDL_FRect& area, std::vector<int>& out) const;
+
+private:
+    int rows = 0, cols = 0;
+    float originX = 0, originY = 0;
+    float cellW = 1, cellH = 1;
+    std::vector<int> cells; // brick index per cell, -1 for gaps in the pattern
+};
@@ -0,0 +1,121 @@
+#include "BrickLayer.h"
+#include "RectBatch.h"
+#include "RenderStats.h"
+#include "RuneAtlas.h"
+#include <cmath>
+
+// Only single-hit bricks live in the layer, multi-hit ones glow every frame
+static bool isStatic(const BrickField& bricks, int i) {
+    return bricks.maxHits(i) <= 1;
+}
+
+// Hit points a brick should be drawn with in the layer (0 = empty)
+static int layerHits(const BrickField& bricks, int i) {
+    return (bricks.alive(i) && isStatic(bricks, i)) ? bricks.hits(i) : 0;
+}
+
+void BrickLayer::invalidate() {
+    fullRedraw = true;
+}
+
+void BrickLayer::clear() {
+    if (texture) SDL_DestroyTexture(texture);
+    texture = nullptr;
+    texW = texH = 0;
+    fullRedraw = true;
+}
+
+// (Re)create the target to match the output size, returns false if targets are unsupported
+bool BrickLayer::ensureTexture(SDL_Renderer* r) {
+    int w, h;
+    SDL_GetCurrentRenderOutputSize(r, &w, &h);
+    if (texture && w == texW && h == texH) return true;
+
+    // window resized - the old contents are the wrong size
+    if (texture) rectBatch.destroyAfterFlush(texture);
+    texture = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    texW = w;
+    texH = h;
+    fullRedraw = true;
+    if (!texture) return false;
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+// Clear a brick's area in the layer and draw it again if it is still there
+void BrickLayer::redrawBrick(SDL_Renderer* r, const BrickField& bricks, int i) {
+    // 1 px of slack covers edge pixels of fractional rects (padding is wider than that)
+    const SDL_FRect& b = bricks.rect(i);
+    SDL_FRect area = { b.x - 1, b.y - 1, b.w + 2, b.h + 2 };
+    render::setDrawColor(r, 0, 0, 0, 0);
+    render::fillRect(r, &area);
+
+    if (layerHits(bricks, i) == 0) return;
+    SDL_Texture* tex;
+    SDL_FRect src, dst;
+    if (runeAtlas.lookup(r, b.x, b.y, b.w, b.h, bricks.runeType(i), bricks.color(i), 0, &tex, &src, &dst)) {
+        render::texture(r, tex, &src, &dst);
+    }
+    else {
+        rasterizeRune(r, b.x, b.y, b.w, b.h, bricks.runeType(i), bricks.color(i));
+    }
+}
+
+void BrickLayer::draw(SDL_Renderer* r, const BrickField& bricks) {
+    RENDER_SUBSYSTEM(BRICKS);
+    bool haveLayer = ensureTexture(r);
+    if (bricks.size() != (int)drawnHits.size()) fullRedraw = true;
+
+    if (haveLayer) {
+        // find what changed before touching the render target
+        bool anyDirty = fullRedraw;
+        for (int i = 0; i < bricks.size() && !anyDirty; ++i) {
+            anyDirty = layerHits(bricks, i) != drawnHits[i];
+        }
+
+        if (anyDirty) {
+            SDL_Texture* prevTarget = SDL_GetRenderTarget(r);
+            SDL_BlendMode prevBlend;
+            SDL_GetRenderDrawBlendMode(r, &prevBlend);
+            SDL_SetRenderTarget(r, texture);
+            SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+
+            if (fullRedraw) {
+                render::setDrawColor(r, 0, 0, 0, 0);
+                render::clear(r);
+                drawnHits.assign(bricks.size(), 0);
+            }
+            for (int i = 0; i < bricks.size(); ++i) {
+                int hits = layerHits(bricks, i);
+                if (hits != drawnHits[i]) {
+                    redrawBrick(r, bricks, i);
+                    drawnHits[i] = hits;
+                }
+            }
+
+            SDL_SetRenderTarget(r, prevTarget);
+            SDL_SetRenderDrawBlendMode(r, prevBlend);
+            fullRedraw = false;
+        }
+    }
+
+    // glowing bricks go underneath, so static bricks keep their edges where halos overlap
+    // every glowing brick shares the field's clock, so they pulse in step
+    float glowIntensity = (std::sin(bricks.glowPhase()) + 1) * 0.5f;
+    for (int i = 0; i < bricks.size(); ++i) {
+        if (!bricks.alive(i)) continue;
+        const SDL_FRect& b = bricks.rect(i);
+        if (!isStatic(bricks, i)) {
+            drawRune(r, b.x, b.y, b.w, b.h, bricks.runeType(i), bricks.color(i), glowIntensity);
+        }
+        else if (!haveLayer) {
+            drawRune(r, b.x, b.y, b.w, b.h, bricks.runeType(i), bricks.color(i));
+        }
+    }
+
+    if (haveLayer) {
+        SDL_FRect full = { 0, 0, (float)texW, (float)texH };
+        rectBatch.texture(texture, full, full);
+    }
+}
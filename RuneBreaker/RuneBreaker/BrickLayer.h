@@ -0,0 +1,31 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <vector>
+#include "BrickField.h"
+
+// Retained render target for the brick field.
+// Single-hit bricks never animate, so they are drawn once into a screen-sized
+// target texture and only the bricks whose state changed since the last frame
+// are re-rendered. Multi-hit bricks glow every frame and are drawn as a cheap
+// overlay from the rune atlas instead. The whole field costs one blit plus one
+// quad per glowing brick.
+class BrickLayer {
+public:
+    // Redraw the whole layer on the next draw (new brick layout)
+    void invalidate();
+
+    // Update the layer for bricks that changed and queue the overlay and layer blit
+    void draw(SDL_Renderer* r, const BrickField& bricks);
+
+    // Destroy the target texture (call before the renderer is destroyed or after a device reset)
+    void clear();
+
+private:
+    bool ensureTexture(SDL_Renderer* r);
+    void redrawBrick(SDL_Renderer* r, const BrickField& bricks, int i);
+
+    SDL_Texture* texture = nullptr;
+    int texW = 0, texH = 0;
+    bool fullRedraw = true;
+    std::vector<int> drawnHits; // hit points each brick was last drawn with (0 = not drawn)
+};
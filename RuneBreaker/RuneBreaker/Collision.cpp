@@ -0,0 +1,54 @@
+#include "Collision.h"
+#include <algorithm>
+#include <limits>
+
+bool intersects(const SDL_FRect& a, const SDL_FRect& b) {
+    return !(a.x + a.w <= b.x || b.x + b.w <= a.x || a.y + a.h <= b.y || b.y + b.h <= a.y);
+}
+
+// Entry and exit times of a moving interval [a0, a1] against [b0, b1] along one axis
+static bool axisTimes(float a0, float a1, float d, float b0, float b1, float& entry, float& exit) {
+    const float inf = std::numeric_limits<float>::infinity();
+    if (d > 0) {
+        entry = (b0 - a1) / d;
+        exit = (b1 - a0) / d;
+    }
+    else if (d < 0) {
+        entry = (b1 - a0) / d;
+        exit = (b0 - a1) / d;
+    }
+    else {
+        // not moving on this axis - either always overlapping or never
+        if (a1 <= b0 || b1 <= a0) return false;
+        entry = -inf;
+        exit = inf;
+    }
+    return true;
+}
+
+bool sweepAABB(const SDL_FRect& a, float dx, float dy, const SDL_FRect& b, SweepHit& hit) {
+    float xEntry, xExit, yEntry, yExit;
+    if (!axisTimes(a.x, a.x + a.w, dx, b.x, b.x + b.w, xEntry, xExit)) return false;
+    if (!axisTimes(a.y, a.y + a.h, dy, b.y, b.y + b.h, yEntry, yExit)) return false;
+
+    // boxes overlap once both axes overlap, and stop when either separates
+    float entry = std::max(xEntry, yEntry);
+    float exit = std::min(xExit, yExit);
+    if (entry > exit || entry > 1.0f || exit <= 0.0f) return false;
+
+    // the axis that was entered last is the face that was hit
+    bool xAxis = xEntry > yEntry;
+    hit.nx = xAxis ? (dx > 0 ? -1.0f : 1.0f) : 0.0f;
+    hit.ny = xAxis ? 0.0f : (dy > 0 ? -1.0f : 1.0f);
+
+    if (entry < 0) {
+        // already overlapping: a hit only if still heading into b along that axis
+        float into = xAxis ? (b.x + b.w / 2) - (a.x + a.w / 2) : (b.y + b.h / 2) - (a.y + a.h / 2);
+        float d = xAxis ? dx : dy;
+        if (d == 0 || (d > 0) != (into > 0)) return false;
+        entry = 0;
+    }
+
+    hit.time = entry;
+    return true;
+}
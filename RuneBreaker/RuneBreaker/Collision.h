@@ -0,0 +1,16 @@
+#pragma once
+#include <SDL3/SDL.h>
+
+// Result of a swept box test
+struct SweepHit {
+    float time; // fraction of the move (0..1) at which the boxes touch
+    float nx, ny; // contact normal on the target, pointing back at the moving box
+};
+
+// Brick collision detection
+bool intersects(const SDL_FRect& a, const SDL_FRect& b);
+
+// Sweep box a along (dx, dy) against static box b.
+// Returns true if a touches b during the move; a box that starts overlapping b
+// only counts as a hit while it is still moving further in.
+bool sweepAABB(const SDL_FRect& a, float dx, float dy, const SDL_FRect& b, SweepHit& hit);
@@ -0,0 +1,161 @@
+#include "Config.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+// Apply one setting, returns false if the key or value is not recognised
+static bool applySetting(const std::string& key, const std::string& value, GameConfig& config) {
+    if (key == "pacing") {
+        return parsePacingMode(value.c_str(), config.pacing);
+    }
+    if (key == "fps") {
+        int fps = std::atoi(value.c_str());
+        if (fps <= 0) return false;
+        config.fpsCap = std::min(fps, 1000);
+        return true;
+    }
+    if (key == "particles") {
+        int cap = std::atoi(value.c_str());
+        if (cap <= 0) return false;
+        config.particleCap = std::min(cap, 1000000);
+        return true;
+    }
+    if (key == "threads") {
+        int threads = std::atoi(value.c_str());
+        if (threads < 0 || (threads == 0 && value != "0")) return false;
+        config.threads = std::min(threads, 64);
+        return true;
+    }
+    if (key == "seed") {
+        char* end = nullptr;
+        unsigned long long seed = std::strtoull(value.c_str(), &end, 10);
+        if (value.empty() || *end != '\0') return false;
+        config.seed = seed;
+        config.fixedSeed = true;
+        return true;
+    }
+    if (key == "record" || key == "replay" || key == "trace" || key == "render-stats") {
+        if (value.empty()) return false;
+        std::string& path = key == "record" ? config.recordPath : key == "replay" ? config.replayPath
+            : key == "trace" ? config.tracePath : config.renderStatsPath;
+        path = value;
+        return true;
+    }
+    if (key == "trace-seconds") {
+        float seconds = (float)std::atof(value.c_str());
+        if (seconds <= 0) return false;
+        config.traceSeconds = std::min(seconds, 120.0f);
+        return true;
+    }
+    if (key == "bench-jobs") {
+        config.benchJobs = (value == "1" || value == "true" || value == "on");
+        return true;
+    }
+    if (key == "rewind") {
+        float seconds = (float)std::atof(value.c_str());
+        if (seconds < 0 || (seconds == 0 && value != "0")) return false;
+        config.rewindSeconds = std::min(seconds, 120.0f);
+        return true;
+    }
+    if (key == "autoplay") {
+        config.autoplay = (value == "1" || value == "true" || value == "on");
+        return true;
+    }
+    if (key == "profiler") {
+        config.profiler = (value == "1" || value == "true" || value == "on");
+        return true;
+    }
+    if (key == "profile") {
+        if (value.empty()) return false;
+        config.profile = value;
+        return true;
+    }
+    if (key == "pacing-stats") {
+        config.pacingStats = (value == "1" || value == "true" || value == "on");
+        return true;
+    }
+    return false;
+}
+
+// Strip spaces and tabs from both ends
+static std::string trim(const std::string& s) {
+    size_t start = s.find_first_not_of(" \t\r");
+    if (start == std::string::npos) return "";
+    size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(start, end - start + 1);
+}
+
+void loadConfigFile(const std::string& path, GameConfig& config) {
+    std::ifstream file(path);
+    if (!file.is_open()) return;
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(file, line)) {
+        lineNo++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos ||
+            !applySetting(trim(line.substr(0, eq)), trim(line.substr(eq + 1)), config)) {
+            std::cerr << path << ":" << lineNo << ": ignoring \"" << line << "\"\n";
+        }
+    }
+}
+
+static void printUsage(const char* exe) {
+    std::cout << "usage: " << exe << " [options]\n"
+        << "  --pacing MODE      uncapped, vsync, adaptive or cap (default vsync)\n"
+        << "  --fps N            frame rate for --pacing cap (default 60)\n"
+        << "  --pacing-stats     log achieved fps and frame-time jitter\n"
+        << "  --particles N      most particles alive at once (default 4096)\n"
+        << "  --threads N        worker threads including the main one (default 0 = one per core)\n"
+        << "  --seed N           play every game with run seed N (default a fresh seed per game)\n"
+        << "  --record FILE      save the inputs of each game to FILE as a replay\n"
+        << "  --replay FILE      play back a replay in real time, checking it step by step\n"
+        << "  --rewind SECONDS   history kept for rewinding with BACKSPACE (default 10, 0 = off)\n"
+        << "  --autoplay         let the game play itself, starting over whenever a game ends\n"
+        << "  --profiler         show the frame profiler overlay (F3 toggles it in game)\n"
+        << "  --trace FILE       capture a timeline and write it to FILE as Chrome trace JSON (F4 and at exit)\n"
+        << "  --trace-seconds N  length of the captured timeline (default 10)\n"
+        << "  --render-stats FILE  write draw calls, color changes, texture binds, vertices and pixels\n"
+        << "                     per subsystem per frame to FILE as CSV\n"
+        << "  --profile NAME     leaderboard profile to record scores under (default PLAYER)\n"
+        << "  --bench-jobs       time the job system on 1 to --threads threads and exit\n"
+        << "options can also be set as key=value lines in runebreaker.cfg\n";
+}
+
+bool parseCommandLine(int argc, char* argv[], GameConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return false;
+        }
+        if (arg.rfind("--", 0) != 0) {
+            std::cerr << "unexpected argument \"" << arg << "\"\n";
+            continue;
+        }
+
+        // accept both --key=value and --key value
+        std::string key = arg.substr(2), value;
+        size_t eq = key.find('=');
+        if (eq != std::string::npos) {
+            value = key.substr(eq + 1);
+            key = key.substr(0, eq);
+        }
+        else if (key == "pacing-stats" || key == "bench-jobs" || key == "autoplay" || key == "profiler") {
+            value = "1";
+        }
+        else if (i + 1 < argc) {
+            value = argv[++i];
+        }
+
+        if (!applySetting(key, value, config)) {
+            std::cerr << "ignoring option --" << key << " \"" << value << "\"\n";
+        }
+    }
+    return true;
+}
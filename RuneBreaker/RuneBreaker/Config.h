@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "FramePacer.h"
+
+// Settings read from runebreaker.cfg and the command line
+struct GameConfig {
+    PacingMode pacing = PacingMode::VSYNC;
+    int fpsCap = 60; // frame rate for PacingMode::CAP
+    bool pacingStats = false; // log achieved fps and jitter
+    int particleCap = 4096; // most particles alive at once
+    int threads = 0; // job system threads including the main one (0 = one per core)
+    bool benchJobs = false; // run the job system benchmark instead of the game
+    bool fixedSeed = false; // play every game with seed instead of a fresh one
+    uint64_t seed = 0;
+    std::string recordPath; // write each game's inputs here as a replay
+    std::string replayPath; // play this replay back instead of showing the menu
+    float rewindSeconds = 10; // game history kept for BACKSPACE rewind (0 = off)
+    bool autoplay = false; // the game plays itself, starting a new game whenever one ends
+    bool profiler = false; // show the frame profiler overlay from the start (F3 toggles it)
+    std::string tracePath; // capture a timeline and write it here as Chrome trace JSON (F4 and at exit)
+    float traceSeconds = 10; // length of the captured timeline
+    std::string renderStatsPath; // write renderer counters per subsystem per frame here as CSV
+    std::string profile = "PLAYER"; // leaderboard profile finished games are recorded under
+};
+
+// Read key=value lines from a config file (a missing file is not an error)
+void loadConfigFile(const std::string& path, GameConfig& config);
+
+// Apply command line flags on top of the config file, returns false if the game should not start
+bool parseCommandLine(int argc, char* argv[], GameConfig& config);
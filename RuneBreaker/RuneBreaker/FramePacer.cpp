@@ -0,0 +1,135 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cmath>
+
+static const double REPORT_INTERVAL = 5.0; // seconds between stats lines
+
+const char* pacingModeName(PacingMode mode) {
+    switch (mode) {
+    case PacingMode::UNCAPPED: return "uncapped";
+    case PacingMode::VSYNC: return "vsync";
+    case PacingMode::ADAPTIVE: return "adaptive";
+    case PacingMode::CAP: return "cap";
+    }
+    return "unknown";
+}
+
+bool parsePacingMode(const char* name, PacingMode& mode) {
+    const PacingMode modes[] = { PacingMode::UNCAPPED, PacingMode::VSYNC, PacingMode::ADAPTIVE, PacingMode::CAP };
+    for (PacingMode m : modes) {
+        if (SDL_strcasecmp(name, pacingModeName(m)) == 0) {
+            mode = m;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Refresh rate of the display the window is on (60 if unknown)
+static int displayRefreshRate(SDL_Window* window) {
+    const SDL_DisplayMode* dm = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+    if (dm && dm->refresh_rate > 0) return (int)std::lround(dm->refresh_rate);
+    return 60;
+}
+
+void FramePacer::init(SDL_Window* window, SDL_Renderer* r, PacingMode mode, int fpsCap, bool logStats) {
+    this->logStats = logStats;
+    frameTimes.assign(HISTORY, 0.0f);
+    frameHead = 0;
+
+    // try the requested mode, falling back to the next best thing
+    if (mode == PacingMode::ADAPTIVE && !SDL_SetRenderVSync(r, SDL_RENDERER_VSYNC_ADAPTIVE)) {
+        SDL_Log("Adaptive vsync unsupported (%s), using vsync", SDL_GetError());
+        mode = PacingMode::VSYNC;
+    }
+    if (mode == PacingMode::VSYNC && !SDL_SetRenderVSync(r, 1)) {
+        fpsCap = displayRefreshRate(window);
+        SDL_Log("Vsync unsupported (%s), capping at %d fps", SDL_GetError(), fpsCap);
+        mode = PacingMode::CAP;
+    }
+    if (mode == PacingMode::CAP || mode == PacingMode::UNCAPPED) {
+        SDL_SetRenderVSync(r, SDL_RENDERER_VSYNC_DISABLED);
+    }
+
+    activeMode = mode;
+    period = SDL_GetPerformanceFrequency() / (Uint64)std::max(1, fpsCap);
+    lastFrame = deadline = lastReport = SDL_GetPerformanceCounter();
+    if (mode == PacingMode::CAP) SDL_Log("Frame pacing: cap %d fps", fpsCap);
+    else SDL_Log("Frame pacing: %s", pacingModeName(mode));
+}
+
+// Sleep most of the remaining time, then spin the rest so we wake on the deadline
+void FramePacer::waitForDeadline() {
+    double freq = (double)SDL_GetPerformanceFrequency();
+    deadline += period;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    // more than a frame behind - don't try to catch up with a burst of short frames
+    if (now > deadline + period) {
+        deadline = now;
+        return;
+    }
+    if (now >= deadline) return;
+
+    double remaining = (deadline - now) / freq;
+    double sleepFor = remaining - oversleep * 1.5;
+    if (sleepFor > 0.0005) {
+        Uint64 sleepStart = SDL_GetPerformanceCounter();
+        SDL_DelayNS((Uint64)(sleepFor * 1e9));
+        double slept = (SDL_GetPerformanceCounter() - sleepStart) / freq;
+        // track how late the OS wakes us, leaning towards the recent worst case
+        double late = std::max(0.0, slept - sleepFor);
+        oversleep = late > oversleep ? late : oversleep * 0.95 + late * 0.05;
+        oversleep = std::clamp(oversleep, 0.0001, 0.004);
+    }
+
+    while (SDL_GetPerformanceCounter() < deadline) {
+        SDL_CPUPauseInstruction();
+    }
+}
+
+void FramePacer::recordFrame(double seconds) {
+    frameTimes[frameHead] = (float)seconds;
+    frameHead = (frameHead + 1) % HISTORY;
+    totalFrames++;
+    totalTime += seconds;
+    worstFrame = std::max(worstFrame, seconds);
+}
+
+void FramePacer::endFrame() {
+    if (activeMode == PacingMode::CAP) waitForDeadline();
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    recordFrame((now - lastFrame) / (double)SDL_GetPerformanceFrequency());
+    lastFrame = now;
+
+    if (logStats && (now - lastReport) / (double)SDL_GetPerformanceFrequency() >= REPORT_INTERVAL) {
+        SDL_Log("%s: %.1f fps, jitter %.2f ms", pacingModeName(activeMode), fps(), jitterMs());
+        lastReport = now;
+    }
+}
+
+double FramePacer::fps() const {
+    int n = (int)std::min<Uint64>(totalFrames, HISTORY);
+    double sum = 0;
+    for (int i = 0; i < n; ++i) sum += frameTimes[i];
+    return sum > 0 ? n / sum : 0;
+}
+
+double FramePacer::jitterMs() const {
+    int n = (int)std::min<Uint64>(totalFrames, HISTORY);
+    if (n < 2) return 0;
+    double mean = 0;
+    for (int i = 0; i < n; ++i) mean += frameTimes[i];
+    mean /= n;
+    double var = 0;
+    for (int i = 0; i < n; ++i) var += (frameTimes[i] - mean) * (frameTimes[i] - mean);
+    return std::sqrt(var / (n - 1)) * 1000.0;
+}
+
+void FramePacer::logSummary() const {
+    if (!logStats || totalFrames == 0) return;
+    SDL_Log("%s: %llu frames, average %.1f fps, worst frame %.2f ms, recent jitter %.2f ms",
+        pacingModeName(activeMode), (unsigned long long)totalFrames, totalFrames / totalTime,
+        worstFrame * 1000.0, jitterMs());
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <vector>
+
+// How the main loop waits between frames
+enum class PacingMode {
+    UNCAPPED, // present as fast as possible
+    VSYNC, // block in present until the display refreshes
+    ADAPTIVE, // vsync, but tear instead of waiting a whole refresh when a frame is late
+    CAP // fixed frame rate, sleep then spin until the deadline
+};
+
+// Name used on the command line and in the config file
+const char* pacingModeName(PacingMode mode);
+bool parsePacingMode(const char* name, PacingMode& mode);
+
+// Frame pacing and frame-time statistics for the main loop
+class FramePacer {
+public:
+    // Apply the pacing mode to the renderer (falls back if vsync is unsupported)
+    void init(SDL_Window* window, SDL_Renderer* r, PacingMode mode, int fpsCap, bool logStats);
+
+    // Call once per frame after SDL_RenderPresent; waits for the frame deadline in CAP mode
+    void endFrame();
+
+    // Print the stats for the whole run
+    void logSummary() const;
+
+    PacingMode mode() const { return activeMode; }
+    double fps() const; // achieved frame rate over the recent window
+    double jitterMs() const; // standard deviation of recent frame times
+
+private:
+    static const int HISTORY = 240; // frames kept for the rolling stats
+
+    void waitForDeadline();
+    void recordFrame(double seconds);
+
+    PacingMode activeMode = PacingMode::UNCAPPED;
+    Uint64 period = 0; // CAP frame period in performance counter ticks
+    Uint64 deadline = 0;
+    Uint64 lastFrame = 0;
+    double oversleep = 0.001; // how late SDL_DelayNS tends to wake, in seconds
+
+    std::vector<float> frameTimes; // ring buffer of recent frame times in seconds
+    int frameHead = 0;
+    bool logStats = false;
+    Uint64 lastReport = 0;
+
+    // whole run totals
+    Uint64 totalFrames = 0;
+    double totalTime = 0, worstFrame = 0;
+};
@@ -0,0 +1,223 @@
+#include "GameRenderer.h"
+#include "Profiler.h"
+#include "RectBatch.h"
+#include "RenderStats.h"
+#include "RuneAtlas.h"
+#include "UiText.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+// Convert hue value to RGB color (for rainbow ball effect)
+static SDL_Color hueToRGB(float h) {
+    Uint8 r = (Uint8)((std::sin(h) + 1) * 127);
+    Uint8 g = (Uint8)((std::sin(h + 2) + 1) * 127);
+    Uint8 b = (Uint8)((std::sin(h + 4) + 1) * 127);
+    return { r, g, b, 255 };
+}
+
+// Position between the previous and current simulation step (alpha 0..1)
+static SDL_FRect interpolate(const SDL_FRect& rect, SDL_FPoint prev, float alpha) {
+    return { prev.x + (rect.x - prev.x) * alpha, prev.y + (rect.y - prev.y) * alpha, rect.w, rect.h };
+}
+
+// Draw paddle with gradient effect 
+static void drawMagicalPaddle(SDL_FRect paddle, bool laser) {
+    RENDER_SUBSYSTEM(PADDLE);
+    // one vertex-colored quad, whatever the paddle width
+    if (laser) {
+        rectBatch.fillGradientH(paddle, { 255, 50, 50, 255 }, { 255, 255, 0, 255 });
+    }
+    else {
+        rectBatch.fillGradientH(paddle, { 255, 50, 255, 255 }, { 0, 255, 255, 255 });
+    }
+}
+
+// Draw ball with rainbow glow effect
+static void drawMagicalBall(SDL_FRect ball, float hue) {
+    RENDER_SUBSYSTEM(BALL);
+    SDL_Color glowColor = hueToRGB(hue);
+
+    // draw glow layers
+    for (int i = 3; i >= 0; --i) {
+        Uint8 alpha = (Uint8)(80 * (i + 1));
+        SDL_FRect glow = { ball.x - i, ball.y - i, ball.w + i * 2, ball.h + i * 2 };
+        rectBatch.fillRect(glow, { glowColor.r, glowColor.g, glowColor.b, alpha });
+    }
+
+    // draw solid ball center
+    rectBatch.fillRect(ball, { 255, 255, 255, 255 });
+}
+
+// Spawn particle trail behind ball
+static void addBallParticle(ParticlePool& particles, Rng& rng, SDL_FRect ball) {
+    Particle p;
+    p.kind = ParticleKind::TRAIL;
+    p.rect = { ball.x + BALL_SIZE / 2 - 1, ball.y + BALL_SIZE / 2 - 1, 2, 2 };
+    p.color = SDL_Color{ 255, 255, 255, 200 };
+    p.lifetime = 0.2f;
+    p.vx = (rng.range(100) - 50) * 0.5f;
+    p.vy = (rng.range(100) - 50) * 0.5f;
+    particles.add(p);
+}
+
+// Spawn explosion particles when brick is destroyed
+static void addBrickParticles(ParticlePool& particles, Rng& rng, const SDL_FRect& brick, SDL_Color color) {
+    int count = 15 + rng.range(10);
+    for (int i = 0; i < count; ++i) {
+        Particle p;
+        p.kind = ParticleKind::DEBRIS;
+        p.rect = { brick.x + brick.w / 2, brick.y + brick.h / 2, 3, 3 };
+        p.color = color;
+        p.lifetime = 0.4f + (rng.range(100) / 200.0f);
+        p.vx = (rng.range(200) - 100) * 2.0f;
+        p.vy = (rng.range(200) - 100) * 2.0f;
+        particles.add(p);
+    }
+}
+
+void GameRenderer::init(int particleCap) {
+    particles.init(particleCap);
+}
+
+void GameRenderer::reset(uint64_t seed) {
+    rng.seed(seed, RngStream::COSMETIC);
+    particles.clear();
+    brickLayer.invalidate();
+}
+
+// Trigger screen shake effect (intensity determines strength)
+void GameRenderer::addShake(float intensity) {
+    shakeIntensity = std::max(shakeIntensity, intensity);
+}
+
+void GameRenderer::onStep(const GameSim& sim, float dt) {
+    for (const SimEvent& e : sim.events()) {
+        switch (e.type) {
+        case SimEventType::BALL_MOVED:
+            if (rng.range(3) == 0) addBallParticle(particles, rng, e.rect);
+            break;
+        case SimEventType::BRICK_BROKEN: {
+            PROFILE_SCOPE("brick burst");
+            addBrickParticles(particles, rng, e.rect, e.color);
+            addShake(e.shake);
+            break;
+        }
+        case SimEventType::LIFE_LOST:
+            addShake(e.shake);
+            break;
+        case SimEventType::NEW_LAYOUT:
+            // the retained brick layer has to be redrawn from scratch
+            brickLayer.invalidate();
+            break;
+        case SimEventType::POWERUP_COLLECTED:
+            break;
+        }
+    }
+    PROFILE_SCOPE("particles");
+    particles.update(dt);
+}
+
+void GameRenderer::update(float dt) {
+    // update rainbow hue for ball effect
+    hue += dt * 2.0f;
+    if (hue > 6.28f) hue -= 6.28f;
+
+    // update screen shake effect
+    if (shakeIntensity > 0) {
+        shakeX = (rng.range(100) - 50) / 50.0f * shakeIntensity;
+        shakeY = (rng.range(100) - 50) / 50.0f * shakeIntensity;
+        shakeIntensity -= dt * 10.0f;
+        if (shakeIntensity < 0) shakeIntensity = 0;
+    }
+}
+
+void GameRenderer::applyShake(SDL_Renderer* r, int w, int h) const {
+    if (shakeIntensity > 0) {
+        SDL_Rect vp = { (int)shakeX, (int)shakeY, w, h };
+        SDL_SetRenderViewport(r, &vp);
+    }
+}
+
+void GameRenderer::clearTextures() {
+    brickLayer.clear();
+}
+
+void GameRenderer::draw(SDL_Renderer* renderer, const GameSim& sim, float alpha, int w, int h) {
+    const SDL_FRect& paddle = sim.paddle();
+    const SDL_FRect& prevPaddle = sim.prevPaddle();
+    SDL_FRect paddleDraw = interpolate(paddle, { prevPaddle.x, prevPaddle.y }, alpha);
+    paddleDraw.w = prevPaddle.w + (paddle.w - prevPaddle.w) * alpha;
+    drawMagicalPaddle(paddleDraw, sim.laserActive());
+
+    // draw balls
+    for (auto& ball : sim.balls()) {
+        if (ball.active) drawMagicalBall(interpolate(ball.rect, ball.prev, alpha), hue);
+    }
+
+    // draw bricks with runes
+    {
+        PROFILE_SCOPE("bricks");
+        brickLayer.draw(renderer, sim.bricks());
+    }
+
+    // draw powerups with icons
+    for (auto& p : sim.powerups()) {
+        SDL_FRect rect = interpolate(p.rect, p.prev, alpha);
+        rectBatch.fillRect(rect, { p.color.r, p.color.g, p.color.b, 255 });
+        const SDL_Color white = { 255, 255, 255, 255 };
+        float cx = rect.x + rect.w / 2;
+        float cy = rect.y + rect.h / 2;
+
+        // draw icon based on powerup type
+        if (p.type == PowerUpType::MULTI_BALL) {
+            SDL_FRect dot1 = { cx - 6, cy - 3, 4, 4 };
+            SDL_FRect dot2 = { cx + 2, cy - 3, 4, 4 };
+            rectBatch.fillRect(dot1, white);
+            rectBatch.fillRect(dot2, white);
+        }
+        else if (p.type == PowerUpType::WIDE_PADDLE) {
+            SDL_FRect bar = { cx - 8, cy, 16, 3 };
+            rectBatch.fillRect(bar, white);
+        }
+        else if (p.type == PowerUpType::EXTRA_LIFE) {
+            ui::drawChar(renderer, cx - 4, cy - 6, '+', white, 2);
+        }
+        else if (p.type == PowerUpType::LASER) {
+            SDL_FRect beam1 = { cx - 2, cy - 8, 2, 8 };
+            SDL_FRect beam2 = { cx + 2, cy - 8, 2, 8 };
+            rectBatch.fillRect(beam1, white);
+            rectBatch.fillRect(beam2, white);
+        }
+    }
+
+    // draw lasers
+    for (auto& laser : sim.lasers()) {
+        rectBatch.fillRect(interpolate(laser.rect, laser.prev, alpha), { 255, 100, 255, 255 });
+    }
+
+    {
+        PROFILE_SCOPE("particles");
+        particles.draw(alpha);
+    }
+
+    // hud
+    PROFILE_SCOPE("hud");
+    ui::drawText(renderer, 20, 20, "SCORE " + std::to_string(sim.score()), { 255,255,255,255 }, 2);
+    ui::drawText(renderer, w - 120, 20, "LIVES " + std::to_string(sim.lives()), { 255,200,200,255 }, 2);
+    ui::drawText(renderer, w / 2 - 50, 20, "LV " + std::to_string(sim.level()), { 200,255,200,255 }, 2);
+
+    // show combo multiplier
+    if (sim.combo() >= 3) {
+        std::string comboText = "x" + std::to_string(sim.combo() / 3 + 1) + " COMBO";
+        ui::drawTextShadow(renderer, w / 2 - 60, 50, comboText, { 255, 255, 100, 255 }, { 100, 100, 50, 255 }, 2);
+    }
+
+    // tutorial text on first level
+    if (sim.level() == 1 && !sim.launched()) {
+        ui::drawText(renderer, w / 2 - 100, h - 100, "SPACE - Launch", { 255,255,255,255 }, 2);
+        ui::drawText(renderer, w / 2 - 100, h - 70, "LEFT/RIGHT - Move", { 255,255,255,255 }, 2);
+    }
+
+    ui::drawText(renderer, 20, h - 30, "P - PAUSE", { 150, 150, 150, 255 }, 1);
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include "GameSim.h"
+#include "ParticlePool.h"
+#include "BrickLayer.h"
+#include "Rng.h"
+
+// Draws a GameSim: paddle, balls, bricks, power-ups, lasers and the HUD, plus
+// the effects the simulation only reports as events (particles and screen
+// shake). Everything here is cosmetic and never feeds back into the game.
+class GameRenderer {
+public:
+    // Size the particle pool
+    void init(int particleCap);
+
+    // Drop particles and effects from the previous game and reseed the effects from the run seed
+    void reset(uint64_t seed);
+
+    // React to the events of the step the simulation just took
+    void onStep(const GameSim& sim, float dt);
+
+    // Advance per-frame effects (rainbow hue, screen shake)
+    void update(float dt);
+
+    // Offset the viewport while the screen is shaking
+    void applyShake(SDL_Renderer* r, int w, int h) const;
+
+    // Queue the game, interpolated between the last two steps (alpha 0..1)
+    void draw(SDL_Renderer* r, const GameSim& sim, float alpha, int w, int h);
+
+    // Destroy cached textures (call before the renderer is destroyed or after a device reset)
+    void clearTextures();
+
+private:
+    void addShake(float intensity);
+
+    ParticlePool particles;
+    Rng rng; // cosmetic stream, separate from the game's so effects never change a run
+    BrickLayer brickLayer; // retained render target holding the bricks that never glow
+    float hue = 0.0f; // global hue for rainbow effects
+    float shakeX = 0, shakeY = 0;
+    float shakeIntensity = 0;
+};
@@ -0,0 +1,558 @@
+#include "GameSim.h"
+#include "Collision.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Create brick layout with increasing difficulty per level
+static void createBricks(BrickField& bricks, Rng& rng, int rows, int cols, float windowW, int level) {
+    int totalPadding = (cols + 1) * BRICK_PADDING;
+    float brickW = (windowW - totalPadding) / (float)cols;
+    bricks.reset(rows, cols, brickW);
+
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            // create patterns with gaps on higher levels
+            bool skip = false;
+            if (level == 2 && r % 2 == 1 && c % 2 == 0) skip = true;
+            if (level == 3 && (r + c) % 3 == 0) skip = true;
+            if (level >= 8 && (r == rows / 2 && c == cols / 2)) skip = true;
+            if (skip) continue;
+
+            float x = BRICK_PADDING + c * (brickW + BRICK_PADDING);
+            float y = BRICK_TOP_OFFSET + r * (BRICK_HEIGHT + BRICK_PADDING);
+
+            // higher levels spawn tougher bricks
+            int maxHits = 1;
+            if (level >= 3 && rng.range(4) == 0) maxHits = 2;
+            if (level >= 6 && rng.range(6) == 0) maxHits = 3;
+
+            int runeType = rng.range(5);
+            bricks.add(r, c, SDL_FRect{ x, y, brickW, (float)BRICK_HEIGHT }, maxHits, runeType);
+        }
+    }
+}
+
+// Ball waiting on the paddle at the start of a life or level
+static Ball newBall() {
+    Ball b;
+    b.rect = { WINDOW_W / 2.0f - BALL_SIZE / 2.0f, WINDOW_H / 2.0f, (float)BALL_SIZE, (float)BALL_SIZE };
+    b.vx = 380.0f;
+    b.vy = -380.0f;
+    b.active = true;
+    b.prev = { b.rect.x, b.rect.y };
+    return b;
+}
+
+// FNV-1a over the bytes of each value added
+struct StateHasher {
+    uint32_t h = 2166136261u;
+
+    template <typename T>
+    void add(const T& value) {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (unsigned char b : bytes) h = (h ^ b) * 16777619u;
+    }
+};
+
+void GameSim::setFieldSize(float w, float h) {
+    fieldW = w;
+    fieldH = h;
+}
+
+void GameSim::reset(int level, uint64_t seed) {
+    runSeed = seed;
+    levelRng.seed(seed, RngStream::LEVEL);
+    dropRng.seed(seed, RngStream::DROPS);
+
+    gameStatus = SimStatus::PLAYING;
+    currentScore = 0;
+    currentLives = 3;
+    paddleRect = { (fieldW - 120) / 2.0f, fieldH - 50.0f, 120, (float)PADDLE_H };
+    prevPaddleRect = paddleRect;
+    laserTimer = 0;
+    powerupTimer = 0;
+    comboTimer = 0;
+
+    // reserve every pool to its cap (one power-up per brick at most), so none grows mid-step
+    ballPool.reserve(MAX_BALLS);
+    laserPool.reserve(MAX_LASERS);
+    powerupPool.reserve(MAX_BRICKS);
+    laserPool.clear();
+
+    stepEvents.clear();
+    startLevel(level);
+}
+
+// Lay out a level and put a fresh ball on the paddle
+void GameSim::startLevel(int level) {
+    currentLevel = level;
+    createBricks(brickField, levelRng, 5 + level / 2, 10, fieldW, level);
+    emit(SimEventType::NEW_LAYOUT, { 0, 0, 0, 0 }, { 0, 0, 0, 0 }, 0);
+
+    ballLaunched = false;
+    ballPool.clear();
+    ballPool.add(newBall());
+    powerupPool.clear();
+    currentCombo = 0;
+    paddleTargetW = 120;
+    stickyActive = false;
+    lasersOn = false;
+    stuckBall = Handle();
+}
+
+void GameSim::nextLevel() {
+    if (currentLevel < MAX_LEVELS) {
+        startLevel(currentLevel + 1);
+    }
+    else {
+        gameStatus = SimStatus::WON;
+    }
+}
+
+void GameSim::emit(SimEventType type, const SDL_FRect& rect, SDL_Color color, float shake) {
+    stepEvents.push_back({ type, rect, color, shake });
+}
+
+// Remember positions at the start of a simulation step
+void GameSim::storePreviousPositions() {
+    prevPaddleRect = paddleRect;
+    for (auto& b : ballPool) b.prev = { b.rect.x, b.rect.y };
+    for (auto& p : powerupPool) p.prev = { p.rect.x, p.rect.y };
+    for (auto& l : laserPool) l.prev = { l.rect.x, l.rect.y };
+}
+
+// spawn power-up from destroyed brick
+void GameSim::spawnPowerUp(const SDL_FRect& brick) {
+    if (dropRng.range(100) < 25) {
+        PowerUp p;
+        p.rect = { brick.x + brick.w / 2 - POWERUP_SIZE / 2, brick.y, POWERUP_SIZE, POWERUP_SIZE };
+        p.type = (PowerUpType)dropRng.range((int)PowerUpType::COUNT);
+        p.vy = POWERUP_SPEED;
+        p.prev = { p.rect.x, p.rect.y };
+
+        // assign color based on type
+        switch (p.type) {
+        case PowerUpType::MULTI_BALL: p.color = { 100, 255, 255, 255 }; break;
+        case PowerUpType::WIDE_PADDLE: p.color = { 100, 255, 100, 255 }; break;
+        case PowerUpType::SLOW_BALL: p.color = { 255, 255, 100, 255 }; break;
+        case PowerUpType::EXTRA_LIFE: p.color = { 255, 100, 100, 255 }; break;
+        case PowerUpType::LASER: p.color = { 255, 100, 255, 255 }; break;
+        case PowerUpType::STICKY: p.color = { 255, 200, 100, 255 }; break;
+        default: p.color = { 200, 200, 200, 255 }; break;
+        }
+        powerupPool.add(p);
+    }
+}
+
+// Take one hit off a brick, breaking it when it runs out
+void GameSim::damageBrick(int i, float shake) {
+    if (brickField.hit(i)) {
+        spawnPowerUp(brickField.rect(i));
+        emit(SimEventType::BRICK_BROKEN, brickField.rect(i), brickField.color(i), shake);
+    }
+}
+
+// Ball landed on the paddle - catch it when sticky, otherwise bounce at an angle
+void GameSim::hitPaddle(int i) {
+    Ball& ball = ballPool[i];
+    if (stickyActive && !ballPool.valid(stuckBall)) {
+        // stick ball to paddle
+        stuckBall = ballPool.handleAt(i);
+        stuckBallOffset = ball.rect.x + BALL_SIZE / 2 - paddleRect.x;
+    }
+    else {
+        // bounce with angle based on hit position
+        float hitPos = (ball.rect.x + BALL_SIZE / 2 - paddleRect.x) / paddleRect.w - 0.5f;
+        ball.vx = hitPos * PADDLE_BOUNCE_SPREAD;
+        ball.vy = -std::abs(ball.vy);
+        ball.rect.y = paddleRect.y - BALL_SIZE;
+    }
+}
+
+void GameSim::saveSnapshot(SimSnapshot& snap) const {
+    snap.status = gameStatus;
+    snap.seed = runSeed;
+    snap.levelRng = levelRng;
+    snap.dropRng = dropRng;
+    snap.level = currentLevel;
+    snap.score = currentScore;
+    snap.lives = currentLives;
+    snap.combo = currentCombo;
+    snap.comboTimer = comboTimer;
+    snap.laserTimer = laserTimer;
+    snap.powerupTimer = powerupTimer;
+    snap.paddle = paddleRect;
+    snap.prevPaddle = prevPaddleRect;
+    snap.paddleTargetW = paddleTargetW;
+    snap.launched = ballLaunched;
+    snap.sticky = stickyActive;
+    snap.lasersOn = lasersOn;
+    snap.stuckBallOffset = stuckBallOffset;
+
+    snap.stuckBall = -1;
+    snap.ballCount = std::min(ballPool.size(), MAX_BALLS);
+    for (int i = 0; i < snap.ballCount; ++i) {
+        snap.balls[i] = ballPool[i];
+        if (ballPool.handleAt(i) == stuckBall) snap.stuckBall = i;
+    }
+    snap.laserCount = std::min(laserPool.size(), MAX_LASERS);
+    for (int i = 0; i < snap.laserCount; ++i) snap.lasers[i] = laserPool[i];
+    snap.powerupCount = std::min(powerupPool.size(), MAX_BRICKS);
+    for (int i = 0; i < snap.powerupCount; ++i) snap.powerups[i] = powerupPool[i];
+    brickField.saveState(snap.bricks);
+}
+
+void GameSim::loadSnapshot(const SimSnapshot& snap) {
+    gameStatus = snap.status;
+    runSeed = snap.seed;
+    levelRng = snap.levelRng;
+    dropRng = snap.dropRng;
+    currentLevel = snap.level;
+    currentScore = snap.score;
+    currentLives = snap.lives;
+    currentCombo = snap.combo;
+    comboTimer = snap.comboTimer;
+    laserTimer = snap.laserTimer;
+    powerupTimer = snap.powerupTimer;
+    paddleRect = snap.paddle;
+    prevPaddleRect = snap.prevPaddle;
+    paddleTargetW = snap.paddleTargetW;
+    ballLaunched = snap.launched != 0;
+    stickyActive = snap.sticky != 0;
+    lasersOn = snap.lasersOn != 0;
+    stuckBallOffset = snap.stuckBallOffset;
+
+    ballPool.clear();
+    stuckBall = Handle();
+    for (int i = 0; i < snap.ballCount; ++i) {
+        Handle h = ballPool.add(snap.balls[i]);
+        if (i == snap.stuckBall) stuckBall = h;
+    }
+    laserPool.clear();
+    for (int i = 0; i < snap.laserCount; ++i) laserPool.add(snap.lasers[i]);
+    powerupPool.clear();
+    for (int i = 0; i < snap.powerupCount; ++i) powerupPool.add(snap.powerups[i]);
+    brickField.loadState(snap.bricks);
+
+    stepEvents.clear();
+    emit(SimEventType::NEW_LAYOUT, { 0, 0, 0, 0 }, { 0, 0, 0, 0 }, 0);
+}
+
+int GameSim::stuckBallIndex() const {
+    if (!stickyActive) return -1;
+    for (int i = 0; i < ballPool.size(); ++i) {
+        if (ballPool.handleAt(i) == stuckBall) return i;
+    }
+    return -1;
+}
+
+uint32_t GameSim::stateHash() const {
+    StateHasher s;
+    s.add(gameStatus);
+    s.add(currentLevel);
+    s.add(currentScore);
+    s.add(currentLives);
+    s.add(currentCombo);
+    s.add(comboTimer);
+    s.add(paddleRect);
+    s.add(paddleTargetW);
+    s.add(ballLaunched);
+    s.add(stickyActive);
+    s.add(lasersOn);
+    s.add(laserTimer);
+    s.add(powerupTimer);
+    // how far each stream has been drawn, so a step that uses one more number shows up at once
+    s.add(levelRng);
+    s.add(dropRng);
+    int stuck = -1;
+    for (int i = 0; i < ballPool.size(); ++i) {
+        const Ball& b = ballPool[i];
+        s.add(b.rect);
+        s.add(b.vx);
+        s.add(b.vy);
+        s.add(b.active);
+        if (ballPool.handleAt(i) == stuckBall) stuck = i;
+    }
+    s.add(stuck);
+    s.add(stuckBallOffset);
+    for (const LaserBeam& l : laserPool) s.add(l.rect);
+    for (const PowerUp& p : powerupPool) {
+        s.add(p.rect);
+        s.add(p.type);
+    }
+    for (int i = 0; i < brickField.size(); ++i) s.add(brickField.hits(i));
+    return s.h;
+}
+
+void GameSim::step(const InputFrame& input, float dt) {
+    stepEvents.clear();
+    if (gameStatus != SimStatus::PLAYING) return;
+
+    // remember where everything was for render interpolation
+    storePreviousPositions();
+
+    // animate multi-hit brick glow
+    brickField.advance(dt);
+
+    // update timers
+    if (comboTimer > 0) comboTimer -= dt;
+    if (comboTimer <= 0) currentCombo = 0;
+    if (laserTimer > 0) laserTimer -= dt;
+    if (laserTimer <= 0) lasersOn = false;
+    if (powerupTimer > 0) powerupTimer -= dt;
+
+    // paddle movement
+    if (input.left) paddleRect.x -= PADDLE_SPEED * dt;
+    if (input.right) paddleRect.x += PADDLE_SPEED * dt;
+    paddleRect.x = std::clamp(paddleRect.x, 0.0f, fieldW - paddleRect.w);
+
+    // smooth paddle width transitions
+    if (paddleRect.w < paddleTargetW) paddleRect.w = std::min(paddleRect.w + 200.0f * dt, paddleTargetW);
+    if (paddleRect.w > paddleTargetW) paddleRect.w = std::max(paddleRect.w - 200.0f * dt, paddleTargetW);
+
+    // f key to skip level (for testing/debugging)
+    if (input.skipLevel) {
+        nextLevel();
+        if (gameStatus != SimStatus::PLAYING) return;
+    }
+
+    // laser firing
+    if (lasersOn && input.launch && laserPool.size() < MAX_LASERS) {
+        LaserBeam laser;
+        laser.rect = { paddleRect.x + paddleRect.w / 2 - 2, paddleRect.y - 10, 4, 15 };
+        laser.vy = -600.0f;
+        laser.prev = { laser.rect.x, laser.rect.y };
+        laserPool.add(laser);
+    }
+
+    moveBalls(input, dt);
+
+    // paddle moved into a ball (balls moving into the paddle are caught by the sweep)
+    for (int i = 0; i < ballPool.size(); ++i) {
+        if (!ballPool[i].active) continue;
+        if (intersects(ballPool[i].rect, paddleRect) && ballPool[i].vy > 0) {
+            hitPaddle(i);
+        }
+    }
+
+    moveLasers(dt);
+    movePowerUps(dt);
+
+    // level complete
+    if (brickField.aliveCount() == 0) nextLevel();
+}
+
+void GameSim::moveBalls(const InputFrame& input, float dt) {
+    // ball launch logic
+    if (!ballLaunched && ballPool.size() > 0) {
+        // attach ball to paddle before launch
+        ballPool[0].rect.x = paddleRect.x + paddleRect.w / 2 - BALL_SIZE / 2;
+        ballPool[0].rect.y = paddleRect.y - BALL_SIZE - 2;
+        if (input.launch) {
+            ballLaunched = true;
+            stuckBall = Handle();
+        }
+        return;
+    }
+
+    // ball physics
+    for (int bi = 0; bi < ballPool.size(); ++bi) {
+        Ball& ball = ballPool[bi];
+        if (!ball.active) continue;
+
+        // handle sticky paddle mechanic
+        if (stickyActive && stuckBall == ballPool.handleAt(bi)) {
+            ball.rect.x = paddleRect.x + stuckBallOffset - BALL_SIZE / 2;
+            ball.rect.y = paddleRect.y - BALL_SIZE - 2;
+            if (input.launch) {
+                stuckBall = Handle();
+                ball.vy = -std::abs(ball.vy);
+            }
+            continue;
+        }
+
+        // move the ball, stopping at everything it touches on the way
+        float dx = ball.vx * dt;
+        float dy = ball.vy * dt;
+        for (int bounce = 0; bounce < MAX_BOUNCES; ++bounce) {
+            SweepHit first = { 1.0f, 0, 0 };
+            int hitBrick = -1;
+            bool onPaddle = false;
+            // only bricks in the cells the move passes through can be hit
+            SDL_FRect swept = {
+                ball.rect.x + std::min(dx, 0.0f), ball.rect.y + std::min(dy, 0.0f),
+                ball.rect.w + std::abs(dx), ball.rect.h + std::abs(dy) };
+            brickField.query(swept, nearby);
+            for (int i : nearby) {
+                SweepHit hit;
+                if (brickField.alive(i) && sweepAABB(ball.rect, dx, dy, brickField.rect(i), hit) && hit.time < first.time) {
+                    first = hit;
+                    hitBrick = i;
+                }
+            }
+            SweepHit hit;
+            if (dy > 0 && sweepAABB(ball.rect, dx, dy, paddleRect, hit) && hit.time < first.time) {
+                first = hit;
+                hitBrick = -1;
+                onPaddle = true;
+            }
+
+            ball.rect.x += dx * first.time;
+            ball.rect.y += dy * first.time;
+            float rest = 1.0f - first.time;
+
+            if (onPaddle) {
+                hitPaddle(bi);
+                if (stuckBall == ballPool.handleAt(bi)) break;
+                dx = ball.vx * dt * rest;
+                dy = ball.vy * dt * rest;
+                continue;
+            }
+            if (hitBrick < 0) break;
+
+            damageBrick(hitBrick, 3.0f);
+            currentCombo++;
+            comboTimer = 2.0f;
+
+            // combo multiplier for scoring
+            int points = 10 * std::max(1, currentCombo / 3);
+            currentScore += points;
+
+            // reflect on the axis of the face we hit and spend the rest of the move
+            if (first.nx != 0) {
+                ball.vx *= -1;
+                dx = -dx;
+            }
+            if (first.ny != 0) {
+                ball.vy *= -1;
+                dy = -dy;
+            }
+            dx *= rest;
+            dy *= rest;
+        }
+
+        // particle trail
+        emit(SimEventType::BALL_MOVED, ball.rect, { 255, 255, 255, 200 }, 0);
+
+        // wall collisions
+        if (ball.rect.x <= 0 || ball.rect.x + BALL_SIZE >= fieldW) {
+            ball.vx *= -1;
+            ball.rect.x = std::clamp(ball.rect.x, 0.0f, fieldW - BALL_SIZE);
+        }
+        if (ball.rect.y <= 0) {
+            ball.vy *= -1;
+            ball.rect.y = 0;
+        }
+
+        // ball falls off screen
+        if (ball.rect.y > fieldH) {
+            ball.active = false;
+        }
+    }
+
+    // remove dead balls
+    for (int i = ballPool.size() - 1; i >= 0; --i) {
+        if (!ballPool[i].active) ballPool.removeAt(i);
+    }
+
+    // lose life
+    if (ballPool.empty()) {
+        currentLives--;
+        emit(SimEventType::LIFE_LOST, paddleRect, { 0, 0, 0, 0 }, 8.0f);
+        if (currentLives <= 0) {
+            gameStatus = SimStatus::GAME_OVER;
+        }
+        else {
+            // reset ball on paddle
+            ballLaunched = false;
+            ballPool.add(newBall());
+            paddleTargetW = 120;
+            stickyActive = false;
+            stuckBall = Handle();
+        }
+    }
+}
+
+void GameSim::moveLasers(float dt) {
+    // laser collisions
+    for (int i = laserPool.size() - 1; i >= 0; --i) {
+        laserPool[i].rect.y += laserPool[i].vy * dt;
+
+        // remove off-screen lasers
+        if (laserPool[i].rect.y < 0) {
+            laserPool.removeAt(i);
+            continue;
+        }
+
+        // check laser-brick collisions
+        brickField.query(laserPool[i].rect, nearby);
+        for (int j : nearby) {
+            if (brickField.alive(j) && intersects(laserPool[i].rect, brickField.rect(j))) {
+                damageBrick(j, 2.0f);
+                currentScore += 10;
+                laserPool.removeAt(i);
+                break;
+            }
+        }
+    }
+}
+
+void GameSim::movePowerUps(float dt) {
+    // powerup collection
+    for (int i = powerupPool.size() - 1; i >= 0; --i) {
+        powerupPool[i].rect.y += powerupPool[i].vy * dt;
+
+        // remove off-screen powerups
+        if (powerupPool[i].rect.y > fieldH) {
+            powerupPool.removeAt(i);
+            continue;
+        }
+
+        // collect powerup
+        if (intersects(powerupPool[i].rect, paddleRect)) {
+            PowerUpType type = powerupPool[i].type;
+            emit(SimEventType::POWERUP_COLLECTED, powerupPool[i].rect, powerupPool[i].color, 0);
+            powerupPool.removeAt(i);
+            applyPowerUp(type);
+        }
+    }
+}
+
+// apply powerup effect
+void GameSim::applyPowerUp(PowerUpType type) {
+    powerupTimer = 10.0f;
+    switch (type) {
+    case PowerUpType::MULTI_BALL:
+        if (ballPool.size() > 0 && ballPool.size() + 2 <= MAX_BALLS) {
+            Ball b1 = ballPool[0];
+            b1.vx = ballPool[0].vx + 150;
+            Ball b2 = ballPool[0];
+            b2.vx = ballPool[0].vx - 150;
+            ballPool.add(b1);
+            ballPool.add(b2);
+        }
+        break;
+    case PowerUpType::WIDE_PADDLE:
+        paddleTargetW = 180;
+        break;
+    case PowerUpType::SLOW_BALL:
+        for (auto& b : ballPool) {
+            b.vx *= 0.7f;
+            b.vy *= 0.7f;
+        }
+        break;
+    case PowerUpType::EXTRA_LIFE:
+        currentLives++;
+        break;
+    case PowerUpType::LASER:
+        lasersOn = true;
+        laserTimer = 8.0f;
+        break;
+    case PowerUpType::STICKY:
+        stickyActive = true;
+        break;
+    default: break;
+    }
+}
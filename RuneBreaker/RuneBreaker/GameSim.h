@@ -0,0 +1,154 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "GameTypes.h"
+#include "BrickField.h"
+#include "HandlePool.h"
+#include "Rng.h"
+
+const int MAX_LEVELS = 10;
+
+// Keys the simulation reads on one step
+struct InputFrame {
+    bool left = false;
+    bool right = false;
+    bool launch = false; // SPACE - launch, release a stuck ball, fire lasers
+    bool skipLevel = false; // F - jump to the next level (testing)
+};
+
+enum class SimStatus { PLAYING, GAME_OVER, WON };
+
+// Things that happened during a step which only matter to the presentation
+enum class SimEventType {
+    BALL_MOVED, // a free ball moved (rect) - trail particles
+    BRICK_BROKEN, // rect, color and shake strength of the broken brick
+    LIFE_LOST, // shake strength
+    NEW_LAYOUT, // a new level's bricks were created
+    POWERUP_COLLECTED, // rect and color of the power-up the paddle caught
+};
+
+struct SimEvent {
+    SimEventType type;
+    SDL_FRect rect;
+    SDL_Color color;
+    float shake;
+};
+
+// Everything a GameSim needs to carry on from a step, in fixed-size arrays so
+// a snapshot is one contiguous block that copies with memcpy. Power-ups only
+// come from bricks, one at most each, so a layout never has more than MAX_BRICKS.
+struct SimSnapshot {
+    SimStatus status;
+    uint64_t seed;
+    Rng levelRng, dropRng;
+    int level, score, lives, combo;
+    float comboTimer, laserTimer, powerupTimer;
+    SDL_FRect paddle, prevPaddle;
+    float paddleTargetW;
+    Uint8 launched, sticky, lasersOn;
+    int stuckBall; // index into balls, -1 for none
+    float stuckBallOffset;
+    int ballCount, laserCount, powerupCount;
+    Ball balls[MAX_BALLS];
+    LaserBeam lasers[MAX_LASERS];
+    PowerUp powerups[MAX_BRICKS];
+    BrickFieldState bricks;
+};
+static_assert(std::is_trivially_copyable<SimSnapshot>::value, "snapshots are copied with memcpy");
+
+// The whole game rules: paddle, balls, bricks, lasers, power-ups, scoring and
+// level progression, advanced in fixed steps from an InputFrame. It never
+// touches a window or renderer, so it runs the same with or without one;
+// everything visual is left to whoever reads its state and events.
+class GameSim {
+public:
+    // Start a new game at level, with seed driving level layouts and drops
+    void reset(int level, uint64_t seed);
+
+    // Play area size, used for walls, paddle limits and brick layout (default WINDOW_W x WINDOW_H)
+    void setFieldSize(float w, float h);
+
+    // Advance the game by dt seconds (normally FIXED_DT)
+    void step(const InputFrame& input, float dt);
+
+    SimStatus status() const { return gameStatus; }
+    int level() const { return currentLevel; }
+    int score() const { return currentScore; }
+    int lives() const { return currentLives; }
+    int combo() const { return currentCombo; }
+    bool launched() const { return ballLaunched; }
+    bool laserActive() const { return lasersOn; }
+    uint64_t seed() const { return runSeed; }
+    float fieldWidth() const { return fieldW; }
+    float fieldHeight() const { return fieldH; }
+
+    const SDL_FRect& paddle() const { return paddleRect; }
+    const SDL_FRect& prevPaddle() const { return prevPaddleRect; } // paddle at the start of the last step
+    const BrickField& bricks() const { return brickField; }
+    const HandlePool<Ball>& balls() const { return ballPool; }
+    const HandlePool<LaserBeam>& lasers() const { return laserPool; }
+    const HandlePool<PowerUp>& powerups() const { return powerupPool; }
+
+    // Index of the ball the sticky paddle is holding, -1 when it holds none
+    int stuckBallIndex() const;
+
+    // Copy the game state out, or put the game back exactly as a snapshot left it.
+    // Loading reports a NEW_LAYOUT event so whoever draws the bricks redraws them.
+    void saveSnapshot(SimSnapshot& snap) const;
+    void loadSnapshot(const SimSnapshot& snap);
+
+    // Hash of everything that decides how the game plays on, compared by replays to catch desyncs
+    uint32_t stateHash() const;
+
+    // Events from the last step, cleared when the next one starts
+    const std::vector<SimEvent>& events() const { return stepEvents; }
+
+private:
+    void startLevel(int level);
+    void nextLevel();
+    void storePreviousPositions();
+    void moveBalls(const InputFrame& input, float dt);
+    void moveLasers(float dt);
+    void movePowerUps(float dt);
+    void applyPowerUp(PowerUpType type);
+    void hitPaddle(int i);
+    void damageBrick(int i, float shake);
+    void spawnPowerUp(const SDL_FRect& brick);
+    void emit(SimEventType type, const SDL_FRect& rect, SDL_Color color, float shake);
+
+    float fieldW = (float)WINDOW_W, fieldH = (float)WINDOW_H;
+    SimStatus gameStatus = SimStatus::PLAYING;
+    uint64_t runSeed = 0;
+    Rng levelRng; // brick toughness and runes
+    Rng dropRng; // power-up drops
+    int currentLevel = 1;
+    int currentScore = 0;
+    int currentLives = 3;
+
+    SDL_FRect paddleRect = { 0, 0, 0, 0 };
+    SDL_FRect prevPaddleRect = { 0, 0, 0, 0 };
+    float paddleTargetW = 120;
+
+    BrickField brickField;
+    HandlePool<Ball> ballPool;
+    HandlePool<LaserBeam> laserPool;
+    HandlePool<PowerUp> powerupPool;
+    bool ballLaunched = false;
+    Handle stuckBall; // ball held by the sticky paddle
+    float stuckBallOffset = 0;
+
+    // scoring system
+    int currentCombo = 0;
+    float comboTimer = 0;
+
+    // active power-up states
+    bool stickyActive = false;
+    bool lasersOn = false;
+    float laserTimer = 0;
+    float powerupTimer = 0;
+
+    std::vector<int> nearby; // bricks returned by grid queries, reused every step
+    std::vector<SimEvent> stepEvents;
+};
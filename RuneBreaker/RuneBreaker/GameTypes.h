@@ -0,0 +1,58 @@
+#pragma once
+#include <SDL3/SDL.h>
+
+const int WINDOW_W = 800;
+const int WINDOW_H = 600;
+const int PADDLE_H = 16;
+const float PADDLE_SPEED = 600.0f;
+const float PADDLE_BOUNCE_SPREAD = 700.0f; // sideways ball speed per paddle width between the center and the hit
+const int BALL_SIZE = 10;
+const int BRICK_PADDING = 4;
+const int BRICK_TOP_OFFSET = 60;
+const int BRICK_HEIGHT = 20;
+const float POWERUP_SPEED = 150.0f;
+const float POWERUP_SIZE = 24.0f;
+const float FIXED_DT = 1.0f / 120.0f; // simulation step (120 Hz, collisions are swept)
+const int MAX_BOUNCES = 4; // contacts a ball resolves within one step
+const int MAX_BALLS = 64; // multi-ball stops adding balls here
+const int MAX_LASERS = 3; // beams in flight at once
+
+// Power-up types
+enum class PowerUpType { MULTI_BALL, WIDE_PADDLE, SLOW_BALL, EXTRA_LIFE, LASER, STICKY, COUNT };
+
+
+// Particle kinds in eviction order - a full pool drops trails before debris
+enum class ParticleKind { TRAIL, DEBRIS };
+
+// Visual particle for explosion effects
+struct Particle {
+    ParticleKind kind;
+    SDL_FRect rect;
+    SDL_Color color;
+    float lifetime; // particles fade out over time
+    float vx, vy;  // velocity for physics
+};
+
+// Collectible power-up that falls from destroyed bricks
+struct PowerUp {
+    SDL_FRect rect;
+    PowerUpType type;
+    float vy; // falling speed
+    SDL_Color color;
+    SDL_FPoint prev; // position at the start of the last step
+};
+
+// Ball object
+struct Ball {
+    SDL_FRect rect;
+    float vx, vy; // velocity vector
+    bool active; // inactive balls are removed
+    SDL_FPoint prev; // position at the start of the last step
+};
+
+// Laser projectile 
+struct LaserBeam {
+    SDL_FRect rect;
+    float vy; // negative velocity (shoots upward)
+    SDL_FPoint prev; // position at the start of the last step
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Stable reference to an item in a HandlePool. A handle outlives its item
+// safely: once the item is removed the slot's generation moves on and the
+// handle stops resolving, even if the slot is reused.
+struct Handle {
+    uint32_t slot = 0;
+    uint32_t generation = 0; // 0 is never issued, so a default handle is always invalid
+
+    bool operator==(const Handle& o) const { return slot == o.slot && generation == o.generation; }
+    bool operator!=(const Handle& o) const { return !(*this == o); }
+};
+
+// Dense item storage addressed through generational handles.
+// Items are packed in one array for iteration; a slot table maps each handle
+// to the item's current position. Removal moves the last item into the gap
+// (so iteration order is not preserved) and recycles the slot through a free
+// list, which makes add and remove O(1) and, once the arrays have grown to the
+// peak count, free of allocations.
+template <typename T>
+class HandlePool {
+public:
+    // Grow the arrays up front so adding up to n items never reallocates
+    void reserve(int n) {
+        items.reserve(n);
+        owners.reserve(n);
+        slots.reserve(n);
+        freeSlots.reserve(n);
+    }
+
+    Handle add(const T& item) {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else {
+            slot = (uint32_t)slots.size();
+            slots.push_back({ 0, 1 });
+        }
+        slots[slot].index = (uint32_t)items.size();
+        items.push_back(item);
+        owners.push_back(slot);
+        return { slot, slots[slot].generation };
+    }
+
+    // Item a handle refers to, or nullptr if it has been removed
+    T* get(Handle h) {
+        if (!valid(h)) return nullptr;
+        return &items[slots[h.slot].index];
+    }
+
+    bool valid(Handle h) const {
+        return h.slot < slots.size() && slots[h.slot].generation == h.generation && h.generation != 0;
+    }
+
+    void remove(Handle h) {
+        if (valid(h)) removeAt((int)slots[h.slot].index);
+    }
+
+    // Remove by position; when iterating, walk backwards so the item moved in has been visited
+    void removeAt(int i) {
+        uint32_t slot = owners[i];
+        int last = (int)items.size() - 1;
+        if (i != last) {
+            items[i] = items[last];
+            owners[i] = owners[last];
+            slots[owners[i]].index = (uint32_t)i;
+        }
+        items.pop_back();
+        owners.pop_back();
+        slots[slot].generation++;
+        if (slots[slot].generation == 0) slots[slot].generation = 1;
+        freeSlots.push_back(slot);
+    }
+
+    // Remove everything, invalidating every outstanding handle
+    void clear() {
+        while (!items.empty()) removeAt((int)items.size() - 1);
+    }
+
+    // Handle of the item at a position
+    Handle handleAt(int i) const { return { owners[i], slots[owners[i]].generation }; }
+
+    int size() const { return (int)items.size(); }
+    bool empty() const { return items.empty(); }
+    T& operator[](int i) { return items[i]; }
+    const T& operator[](int i) const { return items[i]; }
+
+    typename std::vector<T>::iterator begin() { return items.begin(); }
+    typename std::vector<T>::iterator end() { return items.end(); }
+    typename std::vector<T>::const_iterator begin() const { return items.begin(); }
+    typename std::vector<T>::const_iterator end() const { return items.end(); }
+
+private:
+    struct Slot {
+        uint32_t index; // position of the item in items
+        uint32_t generation;
+    };
+
+    std::vector<T> items;
+    std::vector<uint32_t> owners; // slot of each item, parallel to items
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+};
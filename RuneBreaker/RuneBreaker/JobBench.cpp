@@ -0,0 +1,95 @@
+#include "JobBench.h"
+#include "JobSystem.h"
+#include "ParticlePool.h"
+#include "BrickField.h"
+#include "Collision.h"
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+static const int BENCH_PARTICLES = 1 << 20;
+static const int BENCH_BALLS = 1 << 18;
+static const int BENCH_ROWS = 40, BENCH_COLS = 80;
+static const int BENCH_STEPS = 20;
+
+// Milliseconds per call of fn, averaged over BENCH_STEPS calls
+template <typename F>
+static double timeSteps(F fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_STEPS; ++i) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / BENCH_STEPS;
+}
+
+void runJobBenchmark(int maxThreads) {
+    if (maxThreads <= 0) maxThreads = (int)std::max(1u, std::thread::hardware_concurrency());
+
+    // particles that never expire, so every step updates the full pool
+    ParticlePool pool;
+    pool.init(BENCH_PARTICLES);
+    for (int i = 0; i < BENCH_PARTICLES; ++i) {
+        Particle p;
+        p.kind = ParticleKind::DEBRIS;
+        p.rect = { (float)(i % 800), (float)(i % 600), 3, 3 };
+        p.color = { 255, 255, 255, 255 };
+        p.lifetime = 1e9f;
+        p.vx = (float)(i % 200 - 100);
+        p.vy = (float)(i % 150 - 75);
+        pool.add(p);
+    }
+
+    // a dense brick wall and a cloud of balls sweeping through it
+    const float brickW = 20;
+    BrickField bricks;
+    bricks.reset(BENCH_ROWS, BENCH_COLS, brickW);
+    for (int r = 0; r < BENCH_ROWS; ++r) {
+        for (int c = 0; c < BENCH_COLS; ++c) {
+            SDL_FRect rect = { BRICK_PADDING + c * (brickW + BRICK_PADDING),
+                (float)BRICK_TOP_OFFSET + r * (BRICK_HEIGHT + BRICK_PADDING), brickW, (float)BRICK_HEIGHT };
+            bricks.add(r, c, rect, 1, 0);
+        }
+    }
+    float fieldW = BENCH_COLS * (brickW + BRICK_PADDING);
+    float fieldH = BENCH_ROWS * (float)(BRICK_HEIGHT + BRICK_PADDING);
+    std::vector<SDL_FRect> balls(BENCH_BALLS);
+    std::vector<float> toi(BENCH_BALLS);
+    for (int i = 0; i < BENCH_BALLS; ++i) {
+        balls[i] = { (float)((i * 37) % (int)fieldW), BRICK_TOP_OFFSET + (float)((i * 53) % (int)fieldH), (float)BALL_SIZE, (float)BALL_SIZE };
+    }
+
+    std::printf("threads  particles ms  speedup  collisions ms  speedup\n");
+    double baseParticles = 0, baseCollisions = 0;
+    for (int threads = 1; threads <= maxThreads; ++threads) {
+        jobs.init(threads);
+
+        double particleMs = timeSteps([&] { pool.update(1.0f / 120.0f); });
+        double collisionMs = timeSteps([&] {
+            jobs.parallelFor(BENCH_BALLS, 1024, [&](int begin, int end) {
+                std::vector<int> nearby;
+                for (int i = begin; i < end; ++i) {
+                    float dx = (float)(i % 9 - 4), dy = (float)(i % 7 - 3);
+                    SDL_FRect swept = { balls[i].x + std::min(dx, 0.0f), balls[i].y + std::min(dy, 0.0f),
+                        balls[i].w + std::abs(dx), balls[i].h + std::abs(dy) };
+                    bricks.query(swept, nearby);
+                    float first = 1.0f;
+                    for (int b : nearby) {
+                        SweepHit hit;
+                        if (bricks.alive(b) && sweepAABB(balls[i], dx, dy, bricks.rect(b), hit)) first = std::min(first, hit.time);
+                    }
+                    toi[i] = first;
+                }
+            });
+        });
+
+        if (threads == 1) {
+            baseParticles = particleMs;
+            baseCollisions = collisionMs;
+        }
+        std::printf("%7d  %12.3f  %6.2fx  %13.3f  %6.2fx\n", threads, particleMs, baseParticles / particleMs,
+            collisionMs, baseCollisions / collisionMs);
+    }
+    jobs.shutdown();
+}
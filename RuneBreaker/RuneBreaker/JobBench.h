@@ -0,0 +1,5 @@
+#pragma once
+
+// Time a synthetic particle and brick collision load on 1 to maxThreads threads
+// and print the speedup of each thread count (maxThreads 0 = one per core)
+void runJobBenchmark(int maxThreads);
@@ -0,0 +1,119 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+// Queue owned by the current thread (0 for the thread that called init)
+static thread_local int workerIndex = 0;
+
+void JobSystem::init(int threads) {
+    shutdown();
+    if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+
+    queues.clear();
+    for (int i = 0; i < threads; ++i) queues.push_back(std::make_unique<Queue>());
+    quit = false;
+    workerIndex = 0;
+    for (int i = 1; i < threads; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+void JobSystem::shutdown() {
+    if (workers.empty()) return;
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        quit = true;
+    }
+    wake.notify_all();
+    for (auto& t : workers) t.join();
+    workers.clear();
+}
+
+void JobSystem::run(std::function<void()> job, JobCounter* counter) {
+    if (counter) counter->pending++;
+    if (queues.empty()) {
+        // never initialised - behave like a plain function call
+        job();
+        if (counter) counter->pending--;
+        return;
+    }
+
+    Queue& q = *queues[workerIndex];
+    {
+        std::lock_guard<std::mutex> guard(q.lock);
+        q.jobs.push_back({ std::move(job), counter });
+    }
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        queued++;
+    }
+    wake.notify_one();
+}
+
+// Pop from our own queue, or steal from someone else's; returns false if every queue is empty
+bool JobSystem::runOne(int self) {
+    Job job;
+    bool found = false;
+    int n = (int)queues.size();
+    for (int k = 0; k < n && !found; ++k) {
+        int victim = (self + k) % n;
+        Queue& q = *queues[victim];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (q.jobs.empty()) continue;
+        // newest first from our own queue (still in cache), oldest first when stealing
+        if (victim == self) {
+            job = std::move(q.jobs.back());
+            q.jobs.pop_back();
+        }
+        else {
+            job = std::move(q.jobs.front());
+            q.jobs.pop_front();
+        }
+        found = true;
+    }
+    if (!found) return false;
+
+    queued--;
+    if (observer) observer(self, true);
+    job.fn();
+    if (observer) observer(self, false);
+    if (job.counter) job.counter->pending--;
+    return true;
+}
+
+void JobSystem::workerLoop(int index) {
+    workerIndex = index;
+    while (true) {
+        if (runOne(index)) continue;
+
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wake.wait(guard, [this] { return quit || queued > 0; });
+        if (quit && queued == 0) return;
+    }
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    while (counter.pending > 0) {
+        if (!runOne(workerIndex)) std::this_thread::yield();
+    }
+}
+
+void JobSystem::parallelFor(int count, int grain, const std::function<void(int, int)>& fn) {
+    grain = std::max(grain, 1);
+    int threads = threadCount();
+    if (threads <= 1 || count <= grain) {
+        if (count > 0) fn(0, count);
+        return;
+    }
+
+    // a few chunks per thread so stealing can even out uneven ranges
+    int chunks = std::min((count + grain - 1) / grain, threads * 4);
+    int chunkSize = (count + chunks - 1) / chunks;
+    JobCounter counter;
+    for (int begin = chunkSize; begin < count; begin += chunkSize) {
+        int end = std::min(begin + chunkSize, count);
+        run([&fn, begin, end] { fn(begin, end); }, &counter);
+    }
+    // the first chunk runs here rather than waiting for a worker to pick it up
+    fn(0, std::min(chunkSize, count));
+    wait(counter);
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Called on the thread that runs a job, just before (started) and after it; thread is the worker index
+using JobObserver = void (*)(int thread, bool started);
+
+// Counts jobs that have not finished yet; wait() on it to join them
+struct JobCounter {
+    std::atomic<int> pending{ 0 };
+};
+
+// Small work-stealing job scheduler.
+// Every worker (and the main thread) has its own deque: it pushes and pops jobs
+// at the back, while idle workers steal from the front of the others. Jobs
+// report completion through a JobCounter, and a thread waiting on a counter
+// runs queued jobs instead of blocking, so jobs may spawn and wait on more jobs.
+class JobSystem {
+public:
+    ~JobSystem() { shutdown(); }
+
+    // Start worker threads next to the calling thread (threads = total, 0 = one per core)
+    void init(int threads);
+
+    // Finish queued jobs and join the workers
+    void shutdown();
+
+    // Queue a job, counter (if any) drops back once it has run
+    void run(std::function<void()> job, JobCounter* counter = nullptr);
+
+    // Run other jobs until every job counted by counter has finished
+    void wait(JobCounter& counter);
+
+    // Split [0, count) into ranges of at least grain items and run fn(begin, end) on each,
+    // returning once all of them are done. Small ranges run inline.
+    void parallelFor(int count, int grain, const std::function<void(int, int)>& fn);
+
+    // Threads that execute jobs, including the caller
+    int threadCount() const { return (int)queues.size(); }
+
+    // Watch jobs start and finish (for profiling), nullptr to stop; set it while no jobs are running
+    void setObserver(JobObserver fn) { observer = fn; }
+
+private:
+    struct Job {
+        std::function<void()> fn;
+        JobCounter* counter;
+    };
+    struct Queue {
+        std::mutex lock;
+        std::deque<Job> jobs;
+    };
+
+    bool runOne(int self);
+    void workerLoop(int index);
+
+    std::vector<std::unique_ptr<Queue>> queues; // [0] belongs to the thread that called init
+    std::vector<std::thread> workers;
+    std::atomic<int> queued{ 0 };
+    std::atomic<bool> quit{ false };
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    JobObserver observer = nullptr;
+};
+
+extern JobSystem jobs;
@@ -0,0 +1,237 @@
+#include "Leaderboard.h"
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char LEADERBOARD_MAGIC[4] = { 'R', 'B', 'L', 'B' };
+static const uint32_t LEADERBOARD_VERSION = 1;
+
+// The file is the in-memory layout itself (little-endian, fixed-width fields, no pointers)
+struct Leaderboard::Index {
+    uint32_t sequence; // higher is newer, 0 = never written
+    uint16_t count;
+    uint16_t spare; // the slot order does not reference, where the next entry goes
+    uint8_t order[LEADERBOARD_SIZE]; // slots from best to worst score
+    uint32_t crc; // of the profile name and everything above
+};
+
+struct Leaderboard::Profile {
+    char name[PROFILE_NAME_LEN];
+    Index index[2];
+    LeaderboardEntry slots[LEADERBOARD_SIZE + 1];
+};
+
+struct Leaderboard::File {
+    char magic[4];
+    uint32_t version;
+    uint32_t profileCount;
+    uint32_t entriesPerProfile;
+    Profile profiles[MAX_PROFILES];
+};
+
+static_assert(LEADERBOARD_SIZE < 256, "slot numbers are stored in a byte");
+static_assert(sizeof(LeaderboardEntry) == 24, "entries are stored as they are laid out in memory");
+
+bool Leaderboard::open(const std::string& path) {
+    close();
+    const size_t size = sizeof(File);
+    bool fresh = false;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER current;
+    if (!GetFileSizeEx(file, &current) || (size_t)current.QuadPart != size) {
+        // a new file, or one from another version, starts over as zeros
+        LARGE_INTEGER zero = {}, end;
+        end.QuadPart = (LONGLONG)size;
+        SetFilePointerEx(file, zero, nullptr, FILE_BEGIN);
+        SetEndOfFile(file);
+        SetFilePointerEx(file, end, nullptr, FILE_BEGIN);
+        SetEndOfFile(file);
+        fresh = true;
+    }
+    HANDLE map = CreateFileMappingA(file, nullptr, PAGE_READWRITE, 0, (DWORD)size, nullptr);
+    void* view = map ? MapViewOfFile(map, FILE_MAP_ALL_ACCESS, 0, 0, size) : nullptr;
+    if (!view) {
+        if (map) CloseHandle(map);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mapping = map;
+#else
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size != size) {
+        // a new file, or one from another version, starts over as zeros
+        if (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t)size) != 0) {
+            ::close(fd);
+            fd = -1;
+            return false;
+        }
+        fresh = true;
+    }
+    void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+#endif
+    data = (File*)view;
+
+    bool valid = std::memcmp(data->magic, LEADERBOARD_MAGIC, 4) == 0 && data->version == LEADERBOARD_VERSION &&
+        data->profileCount == MAX_PROFILES && data->entriesPerProfile == LEADERBOARD_SIZE;
+    if (fresh || !valid) {
+        std::memset(data, 0, size);
+        std::memcpy(data->magic, LEADERBOARD_MAGIC, 4);
+        data->version = LEADERBOARD_VERSION;
+        data->profileCount = MAX_PROFILES;
+        data->entriesPerProfile = LEADERBOARD_SIZE;
+        flush(data, size);
+    }
+    return true;
+}
+
+void Leaderboard::close() {
+    if (!data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle((HANDLE)mapping);
+    CloseHandle((HANDLE)fileHandle);
+    mapping = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(data, sizeof(File));
+    ::close(fd);
+    fd = -1;
+#endif
+    data = nullptr;
+}
+
+// Write a changed range through to the disk before anything that depends on it
+void Leaderboard::flush(const void* p, size_t size) {
+#ifdef _WIN32
+    FlushViewOfFile(p, size);
+    FlushFileBuffers((HANDLE)fileHandle);
+#else
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)p & ~(page - 1);
+    msync((void*)start, (uintptr_t)p + size - start, MS_SYNC);
+#endif
+}
+
+uint32_t Leaderboard::indexCrc(const Profile& p, const Index& index) {
+    uint32_t crc = SDL_crc32(0, p.name, PROFILE_NAME_LEN);
+    return SDL_crc32(crc, &index, offsetof(Index, crc));
+}
+
+// The newer of the two index copies that passes its CRC, nullptr for an unused profile
+const Leaderboard::Index* Leaderboard::activeIndex(const Profile& p) const {
+    const Index* best = nullptr;
+    for (const Index& index : p.index) {
+        if (index.sequence == 0 || index.crc != indexCrc(p, index)) continue;
+        if (!best || (int32_t)(index.sequence - best->sequence) > 0) best = &index;
+    }
+    return best;
+}
+
+int Leaderboard::profile(const std::string& name) {
+    if (!data) return -1;
+    char key[PROFILE_NAME_LEN] = {};
+    std::memcpy(key, name.data(), std::min(name.size(), (size_t)PROFILE_NAME_LEN - 1));
+
+    int freeProfile = -1;
+    for (int i = 0; i < MAX_PROFILES; ++i) {
+        const Profile& p = data->profiles[i];
+        if (!activeIndex(p)) {
+            if (freeProfile < 0) freeProfile = i;
+        }
+        else if (std::memcmp(p.name, key, PROFILE_NAME_LEN) == 0) {
+            return i;
+        }
+    }
+    if (freeProfile < 0) return -1;
+
+    // claim it: name first, then an empty index that vouches for the name
+    Profile& p = data->profiles[freeProfile];
+    std::memcpy(p.name, key, PROFILE_NAME_LEN);
+    p.index[1].sequence = 0;
+    flush(&p, offsetof(Profile, slots));
+    Index empty = {};
+    empty.sequence = 1;
+    empty.crc = indexCrc(p, empty);
+    p.index[0] = empty;
+    flush(&p.index[0], sizeof(Index));
+    return freeProfile;
+}
+
+std::string Leaderboard::profileName(int profile) const {
+    if (!data || profile < 0 || profile >= MAX_PROFILES) return "";
+    const char* name = data->profiles[profile].name;
+    return std::string(name, strnlen(name, PROFILE_NAME_LEN));
+}
+
+int Leaderboard::insert(int profile, const LeaderboardEntry& entry) {
+    if (!data || profile < 0 || profile >= MAX_PROFILES) return -1;
+    Profile& p = data->profiles[profile];
+    const Index* current = activeIndex(p);
+    if (!current) return -1;
+
+    // first rank with a lower score, so equal scores keep the earlier game ahead
+    int n = current->count;
+    int lo = 0, hi = n;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (p.slots[current->order[mid]].score >= entry.score) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo >= LEADERBOARD_SIZE) return -1;
+
+    // the entry goes into the unreferenced slot, which the live index never reads
+    p.slots[current->spare] = entry;
+    flush(&p.slots[current->spare], sizeof(LeaderboardEntry));
+
+    Index next;
+    next.sequence = current->sequence + 1;
+    if (next.sequence == 0) next.sequence = 1;
+    next.count = (uint16_t)std::min(n + 1, LEADERBOARD_SIZE);
+    // a full table hands its last slot back as the spare, otherwise the next unused slot is
+    next.spare = n < LEADERBOARD_SIZE ? (uint16_t)(n + 1) : current->order[LEADERBOARD_SIZE - 1];
+    std::memcpy(next.order, current->order, lo);
+    next.order[lo] = (uint8_t)current->spare;
+    std::memcpy(next.order + lo + 1, current->order + lo, next.count - lo - 1);
+    std::memset(next.order + next.count, 0, LEADERBOARD_SIZE - next.count);
+    next.crc = indexCrc(p, next);
+
+    Index& target = current == &p.index[0] ? p.index[1] : p.index[0];
+    target = next;
+    flush(&target, sizeof(Index));
+    return lo;
+}
+
+int Leaderboard::count(int profile) const {
+    if (!data || profile < 0 || profile >= MAX_PROFILES) return 0;
+    const Index* index = activeIndex(data->profiles[profile]);
+    return index ? index->count : 0;
+}
+
+const LeaderboardEntry& Leaderboard::entry(int profile, int rank) const {
+    const Profile& p = data->profiles[profile];
+    return p.slots[activeIndex(p)->order[rank]];
+}
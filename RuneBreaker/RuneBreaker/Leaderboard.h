@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+const int LEADERBOARD_SIZE = 100; // entries kept per profile
+const int MAX_PROFILES = 8;
+const int PROFILE_NAME_LEN = 16; // including the terminating zero
+
+// One finished game
+struct LeaderboardEntry {
+    int32_t score;
+    int32_t level; // highest level reached
+    uint64_t seed;
+    int64_t time; // SDL_Time (nanoseconds since 1970) when the game ended
+};
+
+// Top scores for several player profiles in one fixed-size file that is
+// memory-mapped, so the menu reads ranked entries straight out of the mapping
+// without parsing anything.
+//
+// Each profile has LEADERBOARD_SIZE + 1 entry slots and a ranking index (slot
+// numbers, best score first). An insert binary-searches the index, writes the
+// new entry into the one slot the index does not reference, and shifts the
+// slot numbers below it, so nothing is ever sorted or reparsed. The index is
+// double-buffered with a sequence number and a CRC: a new index goes into the
+// inactive copy and is flushed after the entry, so a power cut at any point
+// leaves either the old or the new ranking intact.
+class Leaderboard {
+public:
+    ~Leaderboard() { close(); }
+
+    // Map the file, creating it if missing or unusable
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    // Index of the profile called name, claiming a free one if needed (-1 when all are taken)
+    int profile(const std::string& name);
+    std::string profileName(int profile) const;
+
+    // Add a game to a profile, returns its rank or -1 if it did not make the table
+    int insert(int profile, const LeaderboardEntry& entry);
+
+    int count(int profile) const;
+    const LeaderboardEntry& entry(int profile, int rank) const; // rank 0 is the best score
+
+private:
+    struct Index;
+    struct Profile;
+    struct File;
+
+    static uint32_t indexCrc(const Profile& p, const Index& index);
+    const Index* activeIndex(const Profile& p) const;
+    void flush(const void* p, size_t size);
+
+    File* data = nullptr;
+    void* mapping = nullptr; // platform handles
+    void* fileHandle = nullptr;
+    int fd = -1;
+};
@@ -0,0 +1,196 @@
+#include "ParticlePool.h"
+#include "RectBatch.h"
+#include "RenderStats.h"
+#include "JobSystem.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PARTICLE_SIMD 1
+#include <immintrin.h>
+#endif
+
+// MSVC compiles AVX intrinsics anywhere, GCC and Clang need the function marked
+#if defined(PARTICLE_SIMD) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX __attribute__((target("avx")))
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define TARGET_AVX
+#define TARGET_SSE2
+#endif
+
+static const float GRAVITY = 300.0f; // px/s^2
+static const float FADE_TIME = 0.6f; // lifetime at which a particle is fully opaque
+static const int PARALLEL_GRAIN = 16384; // fewer particles than this update on the calling thread
+
+// Pointers to the arrays one update pass touches
+struct ParticleStreams {
+    float* x; float* y;
+    float* prevX; float* prevY;
+    const float* vx; float* vy;
+    float* life; float* fade;
+};
+
+typedef void (*ParticleKernel)(const ParticleStreams& s, int begin, int end, float dt);
+
+static ParticleKernel updateKernel = nullptr;
+
+// One particle at a time - the reference the SIMD kernels must match exactly
+static void updateScalar(const ParticleStreams& s, int begin, int end, float dt) {
+    for (int i = begin; i < end; ++i) {
+        s.prevX[i] = s.x[i];
+        s.prevY[i] = s.y[i];
+        s.life[i] -= dt;
+        s.x[i] += s.vx[i] * dt;
+        s.y[i] += s.vy[i] * dt;
+        s.vy[i] += GRAVITY * dt;
+        s.fade[i] = std::min(std::max(s.life[i] * (255.0f / FADE_TIME), 0.0f), 255.0f);
+    }
+}
+
+#ifdef PARTICLE_SIMD
+// No fused multiply-add, so every path rounds the same way as the scalar one
+TARGET_SSE2 static void updateSSE2(const ParticleStreams& s, int begin, int end, float dt) {
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 vgdt = _mm_set1_ps(GRAVITY * dt);
+    const __m128 fadeScale = _mm_set1_ps(255.0f / FADE_TIME);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 opaque = _mm_set1_ps(255.0f);
+    int i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 x = _mm_loadu_ps(s.x + i);
+        __m128 y = _mm_loadu_ps(s.y + i);
+        __m128 vy = _mm_loadu_ps(s.vy + i);
+        __m128 life = _mm_sub_ps(_mm_loadu_ps(s.life + i), vdt);
+        _mm_storeu_ps(s.prevX + i, x);
+        _mm_storeu_ps(s.prevY + i, y);
+        _mm_storeu_ps(s.x + i, _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(s.vx + i), vdt)));
+        _mm_storeu_ps(s.y + i, _mm_add_ps(y, _mm_mul_ps(vy, vdt)));
+        _mm_storeu_ps(s.vy + i, _mm_add_ps(vy, vgdt));
+        _mm_storeu_ps(s.life + i, life);
+        _mm_storeu_ps(s.fade + i, _mm_min_ps(_mm_max_ps(_mm_mul_ps(life, fadeScale), zero), opaque));
+    }
+    updateScalar(s, i, end, dt);
+}
+
+TARGET_AVX static void updateAVX(const ParticleStreams& s, int begin, int end, float dt) {
+    const __m256 vdt = _mm256_set1_ps(dt);
+    const __m256 vgdt = _mm256_set1_ps(GRAVITY * dt);
+    const __m256 fadeScale = _mm256_set1_ps(255.0f / FADE_TIME);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 opaque = _mm256_set1_ps(255.0f);
+    int i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 x = _mm256_loadu_ps(s.x + i);
+        __m256 y = _mm256_loadu_ps(s.y + i);
+        __m256 vy = _mm256_loadu_ps(s.vy + i);
+        __m256 life = _mm256_sub_ps(_mm256_loadu_ps(s.life + i), vdt);
+        _mm256_storeu_ps(s.prevX + i, x);
+        _mm256_storeu_ps(s.prevY + i, y);
+        _mm256_storeu_ps(s.x + i, _mm256_add_ps(x, _mm256_mul_ps(_mm256_loadu_ps(s.vx + i), vdt)));
+        _mm256_storeu_ps(s.y + i, _mm256_add_ps(y, _mm256_mul_ps(vy, vdt)));
+        _mm256_storeu_ps(s.vy + i, _mm256_add_ps(vy, vgdt));
+        _mm256_storeu_ps(s.life + i, life);
+        _mm256_storeu_ps(s.fade + i, _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(life, fadeScale), zero), opaque));
+    }
+    _mm256_zeroupper();
+    updateSSE2(s, i, end, dt);
+}
+#endif
+
+void ParticlePool::init(int capacity) {
+    cap = capacity > 0 ? capacity : 1;
+    for (auto* v : { &xs, &ys, &prevXs, &prevYs, &vxs, &vys, &lifetimes, &fades, &sizes }) v->assign(cap, 0.0f);
+    colors.assign(cap, SDL_Color{ 0, 0, 0, 0 });
+    kinds.assign(cap, ParticleKind::TRAIL);
+    clear();
+
+    const char* name = "scalar";
+    updateKernel = updateScalar;
+#ifdef PARTICLE_SIMD
+    if (SDL_HasAVX()) {
+        updateKernel = updateAVX;
+        name = "avx";
+    }
+    else if (SDL_HasSSE2()) {
+        updateKernel = updateSSE2;
+        name = "sse2";
+    }
+#endif
+    SDL_Log("Particles: %d max, %s update", cap, name);
+}
+
+bool ParticlePool::add(const Particle& p) {
+    int slot = count;
+    if (count == cap) {
+        // full - nothing ranks below a trail unless there are trails to replace
+        if (p.kind == ParticleKind::TRAIL && trails == 0) return false;
+
+        // replace the lowest kind, and within it the particle closest to expiring
+        slot = -1;
+        for (int i = 0; i < count; ++i) {
+            if (kinds[i] > p.kind) continue;
+            if (slot < 0 || kinds[i] < kinds[slot] || (kinds[i] == kinds[slot] && lifetimes[i] < lifetimes[slot])) {
+                slot = i;
+            }
+        }
+        if (slot < 0) return false;
+        if (kinds[slot] == ParticleKind::TRAIL) trails--;
+    }
+    else {
+        count++;
+    }
+
+    xs[slot] = prevXs[slot] = p.rect.x;
+    ys[slot] = prevYs[slot] = p.rect.y;
+    vxs[slot] = p.vx;
+    vys[slot] = p.vy;
+    lifetimes[slot] = p.lifetime;
+    fades[slot] = std::min(std::max(p.lifetime * (255.0f / FADE_TIME), 0.0f), 255.0f);
+    sizes[slot] = p.rect.w;
+    colors[slot] = p.color;
+    kinds[slot] = p.kind;
+    if (p.kind == ParticleKind::TRAIL) trails++;
+    return true;
+}
+
+// Swap-and-pop: move the last particle into slot i
+void ParticlePool::remove(int i) {
+    if (kinds[i] == ParticleKind::TRAIL) trails--;
+    int last = --count;
+    xs[i] = xs[last];
+    ys[i] = ys[last];
+    prevXs[i] = prevXs[last];
+    prevYs[i] = prevYs[last];
+    vxs[i] = vxs[last];
+    vys[i] = vys[last];
+    lifetimes[i] = lifetimes[last];
+    fades[i] = fades[last];
+    sizes[i] = sizes[last];
+    colors[i] = colors[last];
+    kinds[i] = kinds[last];
+}
+
+void ParticlePool::update(float dt) {
+    ParticleStreams s = { xs.data(), ys.data(), prevXs.data(), prevYs.data(),
+        vxs.data(), vys.data(), lifetimes.data(), fades.data() };
+    // every particle is independent, so ranges can update on any worker
+    jobs.parallelFor(count, PARALLEL_GRAIN, [&s, dt](int begin, int end) { updateKernel(s, begin, end, dt); });
+
+    // walk backwards so the particle moved into a freed slot has already been checked
+    for (int i = count - 1; i >= 0; --i) {
+        if (lifetimes[i] <= 0) remove(i);
+    }
+}
+
+void ParticlePool::draw(float alpha) const {
+    RENDER_SUBSYSTEM(PARTICLES);
+    for (int i = 0; i < count; ++i) {
+        SDL_FRect rect = {
+            prevXs[i] + (xs[i] - prevXs[i]) * alpha,
+            prevYs[i] + (ys[i] - prevYs[i]) * alpha,
+            sizes[i], sizes[i] };
+        // fade out based on remaining time
+        SDL_Color c = colors[i];
+        rectBatch.fillRect(rect, { c.r, c.g, c.b, (Uint8)fades[i] });
+    }
+}
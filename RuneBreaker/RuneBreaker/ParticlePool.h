@@ -0,0 +1,49 @@
+#pragma once
+#include <vector>
+#include "GameTypes.h"
+
+// Fixed-capacity particle storage.
+// All memory is reserved up front and dead particles are removed by moving the
+// last particle into their slot, so neither spawning nor expiring allocates or
+// shifts the arrays. When the pool is full a new particle replaces the one of
+// the lowest kind with the least life left, and is dropped if every live
+// particle outranks it.
+//
+// Each particle field lives in its own float array so the update runs as one
+// SIMD pass over all of them (AVX, SSE2 or scalar, picked at startup). Drawing
+// is a separate pass that only reads the results.
+class ParticlePool {
+public:
+    // Reserve room for capacity particles, drop any that are live and pick the update kernel
+    void init(int capacity);
+
+    // Add a particle, returns false if there was no room for it
+    bool add(const Particle& p);
+
+    // Move particles, age them and remove the ones whose lifetime ran out
+    void update(float dt);
+
+    // Queue every particle, interpolated between the last two steps (alpha 0..1)
+    void draw(float alpha) const;
+
+    void clear() {
+        count = 0;
+        trails = 0;
+    }
+    int size() const { return count; }
+    int capacity() const { return cap; }
+
+private:
+    void remove(int i);
+
+    // hot - read and written by the update kernel
+    std::vector<float> xs, ys, prevXs, prevYs, vxs, vys, lifetimes, fades;
+    // cold - only needed for eviction and drawing
+    std::vector<float> sizes;
+    std::vector<SDL_Color> colors;
+    std::vector<ParticleKind> kinds;
+
+    int count = 0;
+    int cap = 0;
+    int trails = 0; // live TRAIL particles, lets a full pool of debris reject trails at once
+};
@@ -0,0 +1,235 @@
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "RectBatch.h"
+#include "UiText.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+static const int AVERAGE_FRAMES = 60; // frames the per-scope times are averaged over
+static const Uint64 REFRESH_MS = 250; // how often the overlay text is rebuilt
+static const float GRAPH_H = 60.0f;
+static const float GRAPH_MAX_MS = 33.3f; // frame time at the top of the graph
+static const float TARGET_MS = 1000.0f / 60.0f; // reference line
+
+// Start the frame history over (when recording starts)
+void Profiler::resetFrames() {
+    if (frames.empty()) {
+        frames.resize(HISTORY);
+        for (Frame& f : frames) f.samples.reserve(MAX_SAMPLES);
+    }
+    head = 0;
+    completed = 0;
+    depth = 0;
+    frames[head].begin = SDL_GetPerformanceCounter();
+    frames[head].samples.clear();
+}
+
+void Profiler::setEnabled(bool on) {
+    overlay = on;
+    lines.clear();
+    lastRefresh = 0;
+    // a running capture keeps recording, and keeps the frames it already has
+    bool wasActive = active;
+    active = overlay || capturing();
+    if (active && !wasActive) resetFrames();
+}
+
+void Profiler::startCapture(float seconds) {
+    if (seconds <= 0) return;
+    captureTicks = (Uint64)(seconds * (double)SDL_GetPerformanceFrequency());
+    if (!active) resetFrames();
+    active = true;
+    jobs.setObserver(&Profiler::onJob);
+}
+
+void Profiler::record(const TraceEvent& e) {
+    std::lock_guard<std::mutex> guard(traceLock);
+    trace.push_back(e);
+}
+
+void Profiler::onJob(int thread, bool started) {
+    static thread_local Uint64 jobStart = 0;
+    if (started) {
+        jobStart = SDL_GetPerformanceCounter();
+        return;
+    }
+    profiler.record({ "job", "job", jobStart, SDL_GetPerformanceCounter(), thread, -1 });
+}
+
+void Profiler::event(const char* name, int level) {
+    if (!capturing()) return;
+    record({ name, "game", SDL_GetPerformanceCounter(), 0, 0, level });
+}
+
+void Profiler::beginFrame() {
+    if (!active) return;
+    Uint64 now = SDL_GetPerformanceCounter();
+    frames[head].end = now;
+    if (capturing()) {
+        record({ "frame", "frame", frames[head].begin, now, 0, -1 });
+        // slide the window: drop whatever ended before it
+        std::lock_guard<std::mutex> guard(traceLock);
+        while (!trace.empty() && std::max(trace.front().begin, trace.front().end) + captureTicks < now) {
+            trace.pop_front();
+        }
+    }
+    completed = std::min(completed + 1, HISTORY - 1);
+    head = (head + 1) % HISTORY;
+    frames[head].begin = now;
+    frames[head].samples.clear();
+    depth = 0;
+}
+
+// Scope names are string literals, so the pointer almost always matches; the compare covers copies
+int Profiler::scopeIndex(const char* name) {
+    for (int i = 0; i < scopeCount; ++i) {
+        if (scopeNames[i] == name || std::strcmp(scopeNames[i], name) == 0) return i;
+    }
+    if (scopeCount == MAX_SCOPES) return -1;
+    scopeNames[scopeCount] = name;
+    return scopeCount++;
+}
+
+int Profiler::begin(const char* name) {
+    std::vector<Sample>& samples = frames[head].samples;
+    int scope = scopeIndex(name);
+    if (scope < 0 || (int)samples.size() >= MAX_SAMPLES) return -1;
+    samples.push_back({ scope, depth++, SDL_GetPerformanceCounter(), 0 });
+    return (int)samples.size() - 1;
+}
+
+void Profiler::end(int sample) {
+    std::vector<Sample>& samples = frames[head].samples;
+    // a scope that outlives the frame it started in (or a toggle) has nothing to close
+    if (sample >= (int)samples.size()) return;
+    Sample& s = samples[sample];
+    s.end = SDL_GetPerformanceCounter();
+    depth--;
+    if (capturing()) record({ scopeNames[s.scope], "scope", s.begin, s.end, 0, -1 });
+}
+
+// Rebuild the overlay lines from the completed frames
+void Profiler::refreshText() {
+    lines.clear();
+    if (completed == 0) return;
+    const double msPerTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+    std::vector<float> times;
+    times.reserve(completed);
+    for (int i = 1; i <= completed; ++i) {
+        const Frame& f = frames[(head - i + HISTORY) % HISTORY];
+        times.push_back((float)((f.end - f.begin) * msPerTick));
+    }
+    float last = times[0];
+    std::sort(times.begin(), times.end());
+    float p50 = times[times.size() / 2];
+    float p99 = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+
+    // inclusive time per scope, averaged over the recent frames
+    double total[MAX_SCOPES] = {};
+    int frameCount = std::min(completed, AVERAGE_FRAMES);
+    for (int i = 1; i <= frameCount; ++i) {
+        for (const Sample& s : frames[(head - i + HISTORY) % HISTORY].samples) {
+            if (s.end > s.begin) total[s.scope] += (double)(s.end - s.begin);
+        }
+    }
+
+    char line[64];
+    SDL_snprintf(line, sizeof(line), "FRAME %6.2f MS", last);
+    lines.push_back(line);
+    SDL_snprintf(line, sizeof(line), "P50 %5.2f P99 %5.2f", p50, p99);
+    lines.push_back(line);
+
+    // scopes in the order and nesting of the last frame
+    bool listed[MAX_SCOPES] = {};
+    for (const Sample& s : frames[(head - 1 + HISTORY) % HISTORY].samples) {
+        if (listed[s.scope]) continue;
+        listed[s.scope] = true;
+        std::string name = std::string(s.depth * 2, ' ') + scopeNames[s.scope];
+        SDL_snprintf(line, sizeof(line), "%-14.14s %6.2f", name.c_str(), total[s.scope] * msPerTick / frameCount);
+        lines.push_back(line);
+    }
+}
+
+void Profiler::drawOverlay(SDL_Renderer* r, int w) {
+    if (!overlay) return;
+    Uint64 now = SDL_GetTicks();
+    if (lastRefresh == 0 || now - lastRefresh >= REFRESH_MS) {
+        refreshText();
+        lastRefresh = now;
+    }
+
+    const float panelW = (float)HISTORY + 20;
+    const float lineH = 18.0f;
+    float x = (float)w - panelW - 10;
+    float y = 10;
+    float panelH = lines.size() * lineH + GRAPH_H + 30;
+    rectBatch.fillRect({ x, y, panelW, panelH }, { 0, 0, 0, 170 }, SDL_BLENDMODE_BLEND);
+
+    for (size_t i = 0; i < lines.size(); ++i) {
+        SDL_Color col = i < 2 ? SDL_Color{ 255, 255, 150, 255 } : SDL_Color{ 200, 220, 255, 255 };
+        ui::drawText(r, x + 10, y + 10 + i * lineH, lines[i], col, 2);
+    }
+
+    // one bar per frame, newest on the right
+    const double msPerTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    float gx = x + 10, gy = y + panelH - 10;
+    for (int i = 1; i <= completed; ++i) {
+        const Frame& f = frames[(head - i + HISTORY) % HISTORY];
+        float ms = (float)((f.end - f.begin) * msPerTick);
+        float barH = std::min(ms / GRAPH_MAX_MS, 1.0f) * GRAPH_H;
+        SDL_Color col = ms <= TARGET_MS * 1.1f ? SDL_Color{ 80, 220, 120, 255 }
+            : ms <= GRAPH_MAX_MS ? SDL_Color{ 240, 200, 80, 255 } : SDL_Color{ 240, 80, 80, 255 };
+        rectBatch.fillRect({ gx + (float)(HISTORY - i), gy - barH, 1, barH }, col);
+    }
+    rectBatch.fillRect({ gx, gy - TARGET_MS / GRAPH_MAX_MS * GRAPH_H, (float)HISTORY, 1 }, { 255, 255, 255, 120 }, SDL_BLENDMODE_BLEND);
+}
+
+bool Profiler::writeTrace(const std::string& path) {
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> guard(traceLock);
+        events.assign(trace.begin(), trace.end());
+    }
+    std::ofstream file(path);
+    if (!file) return false;
+
+    // timestamps in microseconds from the start of the window
+    const double usPerTick = 1e6 / (double)SDL_GetPerformanceFrequency();
+    Uint64 base = UINT64_MAX;
+    int threads = 1;
+    for (const TraceEvent& e : events) {
+        base = std::min(base, e.begin);
+        threads = std::max(threads, e.thread + 1);
+    }
+
+    char line[256];
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"RuneBreaker\"}}";
+    for (int t = 0; t < threads; ++t) {
+        SDL_snprintf(line, sizeof(line),
+            ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+            t, t == 0 ? "main" : ("worker " + std::to_string(t)).c_str());
+        file << line;
+    }
+    for (const TraceEvent& e : events) {
+        double ts = (e.begin - base) * usPerTick;
+        if (e.end == 0) {
+            SDL_snprintf(line, sizeof(line),
+                ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"level\":%d}}",
+                e.name, e.category, ts, e.thread, e.level);
+        }
+        else {
+            SDL_snprintf(line, sizeof(line),
+                ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                e.name, e.category, ts, (e.end - e.begin) * usPerTick, e.thread);
+        }
+        file << line;
+    }
+    file << "\n]}\n";
+    file.close();
+    if (!file) return false;
+    SDL_Log("Wrote %d trace events to %s", (int)events.size(), path.c_str());
+    return true;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scoped CPU timers for the main thread and an overlay that shows them.
+// Each PROFILE_SCOPE records a begin/end pair of SDL_GetPerformanceCounter
+// ticks into the current frame of a ring buffer; the overlay averages them per
+// scope name and graphs recent frame times. While the profiler is off a scope
+// costs two never-taken branches and no calls: the constructor tests
+// profiler.active, and the destructor tests the sample index the constructor
+// stored (-1).
+//
+// A capture additionally keeps the last few seconds of frames, scopes, jobs
+// run by the job system and marked game events, and writes them as Chrome
+// trace-event JSON (chrome://tracing, ui.perfetto.dev).
+class Profiler {
+public:
+    static const int HISTORY = 240; // frames kept in the ring
+    static const int MAX_SCOPES = 32; // distinct scope names
+    static const int MAX_SAMPLES = 512; // scopes recorded per frame, later ones are dropped
+
+    struct Sample {
+        int scope; // index into scopeNames
+        int depth; // scopes open around this one
+        Uint64 begin, end;
+    };
+
+    // Show or hide the overlay (its history restarts empty)
+    void setEnabled(bool on);
+    bool enabled() const { return overlay; }
+
+    // Keep a rolling window of the last seconds of timeline for writeTrace
+    void startCapture(float seconds);
+    bool capturing() const { return captureTicks != 0; }
+
+    // Write the captured window as trace-event JSON, returns false if the file could not be written
+    bool writeTrace(const std::string& path);
+
+    // Mark a game event on the capture timeline (name must outlive the capture)
+    void event(const char* name, int level);
+
+    // Close the previous frame and start a new one (call at the top of the main loop)
+    void beginFrame();
+
+    // Open a scope, returns the sample to close it with
+    int begin(const char* name);
+    void end(int sample);
+
+    // Draw per-scope times and the frame-time graph in the top right corner
+    void drawOverlay(SDL_Renderer* r, int w);
+
+    bool active = false; // overlay or capture is on, read inline by ProfileScope
+
+private:
+    struct Frame {
+        Uint64 begin = 0, end = 0;
+        std::vector<Sample> samples;
+    };
+
+    // One slice or instant on the capture timeline
+    struct TraceEvent {
+        const char* name;
+        const char* category;
+        Uint64 begin, end; // end == 0 for an instant
+        int thread; // 0 = main, otherwise the job worker index
+        int level; // -1 if not a game event
+    };
+
+    int scopeIndex(const char* name);
+    void resetFrames();
+    void refreshText();
+    void record(const TraceEvent& e);
+    static void onJob(int thread, bool started);
+
+    bool overlay = false;
+
+    std::vector<Frame> frames; // ring of HISTORY frames, head is the one being recorded
+    int head = 0;
+    int completed = 0; // frames that have been closed, up to HISTORY - 1
+    int depth = 0;
+    const char* scopeNames[MAX_SCOPES] = {};
+    int scopeCount = 0;
+
+    // the overlay text only changes a few times a second, so its text runs stay cached
+    std::vector<std::string> lines;
+    Uint64 lastRefresh = 0;
+
+    // capture window, shared with the job threads
+    std::mutex traceLock;
+    std::deque<TraceEvent> trace;
+    Uint64 captureTicks = 0; // length of the window
+};
+
+extern Profiler profiler;
+
+// Times the enclosing block when the profiler is on.
+// The destructor's compare is the second of the two branches a disabled scope costs.
+// It tests a local instead of profiler.active, so a toggle inside the block cannot unbalance begin/end.
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : sample(profiler.active ? profiler.begin(name) : -1) {}
+    ~ProfileScope() {
+        if (sample >= 0) profiler.end(sample);
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    int sample;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
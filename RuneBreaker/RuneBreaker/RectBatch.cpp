@@ -0,0 +1,128 @@
+#include "RectBatch.h"
+#include "RenderStats.h"
+#include <algorithm>
+
+// Overlap test for run bounds
+static bool overlaps(const SDL_FRect& a, const SDL_FRect& b) {
+    return !(a.x + a.w <= b.x || b.x + b.w <= a.x || a.y + a.h <= b.y || b.y + b.h <= a.y);
+}
+
+// Grow bounds to cover rect
+static void growBounds(SDL_FRect& bounds, const SDL_FRect& rect) {
+    float x0 = std::min(bounds.x, rect.x);
+    float y0 = std::min(bounds.y, rect.y);
+    float x1 = std::max(bounds.x + bounds.w, rect.x + rect.w);
+    float y1 = std::max(bounds.y + bounds.h, rect.y + rect.h);
+    bounds = { x0, y0, x1 - x0, y1 - y0 };
+}
+
+// Find a run this quad can join without changing what ends up on screen.
+// A quad may be pulled back into an earlier run with the same texture and blend
+// mode as long as nothing queued after that run overlaps it.
+RectBatch::Run& RectBatch::runFor(SDL_Texture* tex, SDL_BlendMode blend, const SDL_FRect& dst) {
+    int oldest = std::max(0, runCount - MERGE_WINDOW);
+    for (int i = runCount - 1; i >= oldest; --i) {
+        Run& run = runs[i];
+        if (run.texture == tex && run.blend == blend) {
+            growBounds(run.bounds, dst);
+            return run;
+        }
+        if (overlaps(run.bounds, dst)) break;
+    }
+
+    // start a new run, reusing an old one's buffers if there is one
+    if (runCount == (int)runs.size()) runs.emplace_back();
+    Run& run = runs[runCount++];
+    run.texture = tex;
+    run.blend = blend;
+    run.bounds = dst;
+    run.vertices.clear();
+    run.indices.clear();
+    return run;
+}
+
+// Convert an 8-bit color to the float color SDL_Vertex uses
+static SDL_FColor toFColor(SDL_Color c) {
+    return { c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f };
+}
+
+// Append two triangles covering dst, colors given clockwise from the top-left corner
+void RectBatch::addQuad(Run& run, const SDL_FRect& dst, const SDL_FColor colors[4], float u0, float v0, float u1, float v1) {
+    int base = (int)run.vertices.size();
+    run.vertices.push_back({ { dst.x, dst.y }, colors[0], { u0, v0 } });
+    run.vertices.push_back({ { dst.x + dst.w, dst.y }, colors[1], { u1, v0 } });
+    run.vertices.push_back({ { dst.x + dst.w, dst.y + dst.h }, colors[2], { u1, v1 } });
+    run.vertices.push_back({ { dst.x, dst.y + dst.h }, colors[3], { u0, v1 } });
+
+    const int quad[6] = { 0, 1, 2, 0, 2, 3 };
+    for (int i : quad) run.indices.push_back(base + i);
+}
+
+void RectBatch::fillRect(const SDL_FRect& rect, SDL_Color color, SDL_BlendMode blend) {
+    SDL_FColor c = toFColor(color);
+    const SDL_FColor colors[4] = { c, c, c, c };
+    addQuad(runFor(nullptr, blend, rect), rect, colors, 0, 0, 0, 0);
+    frameStats.rects++;
+    renderStats.countQueued(rect, nullptr);
+}
+
+void RectBatch::fillGradient(const SDL_FRect& rect, const SDL_Color corners[4], SDL_BlendMode blend) {
+    const SDL_FColor colors[4] = { toFColor(corners[0]), toFColor(corners[1]), toFColor(corners[2]), toFColor(corners[3]) };
+    addQuad(runFor(nullptr, blend, rect), rect, colors, 0, 0, 0, 0);
+    frameStats.rects++;
+    renderStats.countQueued(rect, nullptr);
+}
+
+void RectBatch::fillGradientH(const SDL_FRect& rect, SDL_Color left, SDL_Color right, SDL_BlendMode blend) {
+    const SDL_Color corners[4] = { left, right, right, left };
+    fillGradient(rect, corners, blend);
+}
+
+void RectBatch::texture(SDL_Texture* tex, const SDL_FRect& src, const SDL_FRect& dst, SDL_Color color) {
+    float texW, texH;
+    SDL_GetTextureSize(tex, &texW, &texH);
+    SDL_BlendMode blend;
+    SDL_GetTextureBlendMode(tex, &blend);
+
+    SDL_FColor c = toFColor(color);
+    const SDL_FColor colors[4] = { c, c, c, c };
+    addQuad(runFor(tex, blend, dst), dst, colors,
+        src.x / texW, src.y / texH, (src.x + src.w) / texW, (src.y + src.h) / texH);
+    frameStats.quads++;
+    renderStats.countQueued(dst, tex);
+}
+
+void RectBatch::flush(SDL_Renderer* r) {
+    drawQueued(r);
+    lastStats = frameStats;
+    clear();
+}
+
+void RectBatch::drawQueued(SDL_Renderer* r) {
+    RENDER_SUBSYSTEM(BATCH);
+    SDL_BlendMode prevBlend;
+    SDL_GetRenderDrawBlendMode(r, &prevBlend);
+
+    for (int i = 0; i < runCount; ++i) {
+        Run& run = runs[i];
+        // untextured geometry uses the draw blend mode, textured uses the texture's own
+        if (!run.texture) SDL_SetRenderDrawBlendMode(r, run.blend);
+        render::geometry(r, run.texture, run.vertices.data(), (int)run.vertices.size(),
+            run.indices.data(), (int)run.indices.size());
+        frameStats.drawCalls++;
+    }
+
+    SDL_SetRenderDrawBlendMode(r, prevBlend);
+    runCount = 0;
+}
+
+void RectBatch::clear() {
+    runCount = 0;
+    frameStats = Stats();
+    for (SDL_Texture* tex : retired) SDL_DestroyTexture(tex);
+    retired.clear();
+}
+
+void RectBatch::destroyAfterFlush(SDL_Texture* tex) {
+    retired.push_back(tex);
+}
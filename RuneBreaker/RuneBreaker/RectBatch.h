@@ -0,0 +1,67 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <vector>
+
+// Per-frame batch of colored rects and textured quads.
+// Everything drawn through the batch is turned into vertices and submitted with
+// one SDL_RenderGeometry call per run of matching (texture, blend mode), so a
+// frame of thousands of small rects costs a handful of draw calls.
+class RectBatch {
+public:
+    // counters for the last flushed frame
+    struct Stats {
+        int rects = 0; // solid rects submitted
+        int quads = 0; // textured quads submitted
+        int drawCalls = 0; // SDL_RenderGeometry calls issued
+    };
+
+    // Queue a solid rect (replaces SDL_SetRenderDrawColor + SDL_RenderFillRect)
+    void fillRect(const SDL_FRect& rect, SDL_Color color, SDL_BlendMode blend = SDL_BLENDMODE_NONE);
+
+    // Queue a rect with a color per corner (top-left, top-right, bottom-right, bottom-left),
+    // interpolated across the rect by the GPU
+    void fillGradient(const SDL_FRect& rect, const SDL_Color corners[4], SDL_BlendMode blend = SDL_BLENDMODE_NONE);
+
+    // Left-to-right gradient shorthand
+    void fillGradientH(const SDL_FRect& rect, SDL_Color left, SDL_Color right, SDL_BlendMode blend = SDL_BLENDMODE_NONE);
+
+    // Queue a textured quad, tinted by color (replaces SDL_RenderTexture)
+    void texture(SDL_Texture* tex, const SDL_FRect& src, const SDL_FRect& dst, SDL_Color color = { 255, 255, 255, 255 });
+
+    // Submit everything queued this frame, in order
+    void flush(SDL_Renderer* r);
+
+    // Draw what is queued so far and keep counting the frame (before a texture it reads is redrawn)
+    void drawQueued(SDL_Renderer* r);
+
+    // Drop everything queued without drawing it
+    void clear();
+
+    // Destroy a texture once the quads already queued from it have been drawn
+    void destroyAfterFlush(SDL_Texture* tex);
+
+    const Stats& stats() const { return lastStats; }
+
+private:
+    // how far back a quad may look for a run it can join
+    static const int MERGE_WINDOW = 8;
+
+    struct Run {
+        SDL_Texture* texture = nullptr;
+        SDL_BlendMode blend = SDL_BLENDMODE_NONE;
+        SDL_FRect bounds = {}; // union of every quad in the run
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+    };
+
+    Run& runFor(SDL_Texture* tex, SDL_BlendMode blend, const SDL_FRect& dst);
+    void addQuad(Run& run, const SDL_FRect& dst, const SDL_FColor colors[4], float u0, float v0, float u1, float v1);
+
+    std::vector<Run> runs; // run objects are reused between frames to keep their buffers
+    int runCount = 0;
+    std::vector<SDL_Texture*> retired; // evicted cache textures waiting for the flush
+    Stats frameStats, lastStats;
+};
+
+// the frame batch every draw helper submits to (defined in Main.cpp)
+extern RectBatch rectBatch;
@@ -0,0 +1,146 @@
+#include "RenderStats.h"
+#include <cmath>
+
+static const char* SUBSYSTEM_NAMES[] = { "other", "runes", "text", "particles", "paddle", "ball", "bricks", "batch" };
+static_assert(sizeof(SUBSYSTEM_NAMES) / sizeof(SUBSYSTEM_NAMES[0]) == (int)RenderSubsystem::COUNT, "a name per subsystem");
+
+const char* renderSubsystemName(RenderSubsystem s) {
+    return SUBSYSTEM_NAMES[(int)s];
+}
+
+static double area(const SDL_FRect& rect) {
+    return (double)rect.w * rect.h;
+}
+
+// Area of the whole render target (window or texture)
+static double targetArea(SDL_Renderer* r) {
+    int w = 0, h = 0;
+    SDL_GetCurrentRenderOutputSize(r, &w, &h);
+    return (double)w * h;
+}
+
+bool RenderStats::open(const std::string& path) {
+    close();
+    file.open(path);
+    if (!file) return false;
+    file << "frame,subsystem,fills,color_changes,texture_binds,vertices,pixels\n";
+    active = true;
+    frameIndex = 0;
+    for (RenderCounters& c : frame) c = RenderCounters();
+    for (RenderCounters& c : total) c = RenderCounters();
+    return true;
+}
+
+void RenderStats::close() {
+    if (file.is_open()) file.close();
+    active = false;
+}
+
+void RenderStats::endFrame() {
+    if (!active) return;
+    for (int i = 0; i < (int)RenderSubsystem::COUNT; ++i) {
+        const RenderCounters& c = frame[i];
+        file << frameIndex << ',' << SUBSYSTEM_NAMES[i] << ',' << c.fills << ',' << c.colorChanges << ','
+            << c.textureBinds << ',' << c.vertices << ',' << (long long)std::llround(c.pixels) << '\n';
+        total[i].fills += c.fills;
+        total[i].colorChanges += c.colorChanges;
+        total[i].textureBinds += c.textureBinds;
+        total[i].vertices += c.vertices;
+        total[i].pixels += c.pixels;
+        frame[i] = RenderCounters();
+    }
+    frameIndex++;
+}
+
+void RenderStats::logSummary() const {
+    if (frameIndex == 0) return;
+    SDL_Log("Renderer work per frame over %lld frames:", frameIndex);
+    for (int i = 0; i < (int)RenderSubsystem::COUNT; ++i) {
+        const RenderCounters& c = total[i];
+        // many fills covering a few pixels each is the signature of a per-pixel rect loop
+        SDL_Log("  %-9s %8.1f fills %7.1f colors %6.1f binds %9.1f vertices %10.0f px (%.1f px/fill)",
+            SUBSYSTEM_NAMES[i], c.fills / (double)frameIndex, c.colorChanges / (double)frameIndex,
+            c.textureBinds / (double)frameIndex, c.vertices / (double)frameIndex, c.pixels / frameIndex,
+            c.fills > 0 ? c.pixels / c.fills : 0.0);
+    }
+}
+
+void RenderStats::countBind(SDL_Texture* tex, SDL_Texture*& last) {
+    if (tex && tex != last) now().textureBinds++;
+    if (tex) last = tex;
+}
+
+void RenderStats::countFill(double pixels, int vertices, SDL_Texture* tex) {
+    if (!active) return;
+    RenderCounters& c = now();
+    c.fills++;
+    c.vertices += vertices;
+    c.pixels += pixels;
+    countBind(tex, lastBound);
+}
+
+void RenderStats::countQueued(const SDL_FRect& rect, SDL_Texture* tex) {
+    if (!active) return;
+    RenderCounters& c = now();
+    c.fills++;
+    c.vertices += 4;
+    c.pixels += area(rect);
+    countBind(tex, lastQueued);
+}
+
+void RenderStats::countGeometry(SDL_Texture* tex, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount) {
+    if (!active) return;
+    double pixels = 0;
+    for (int i = 0; i + 2 < indexCount; i += 3) {
+        const SDL_FPoint& a = vertices[indices[i]].position;
+        const SDL_FPoint& b = vertices[indices[i + 1]].position;
+        const SDL_FPoint& c = vertices[indices[i + 2]].position;
+        pixels += std::fabs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y)) * 0.5;
+    }
+    countFill(pixels, vertexCount, tex);
+}
+
+void RenderStats::countColor(SDL_Color c) {
+    if (!active) return;
+    if (haveColor && c.r == lastColor.r && c.g == lastColor.g && c.b == lastColor.b && c.a == lastColor.a) return;
+    now().colorChanges++;
+    lastColor = c;
+    haveColor = true;
+}
+
+namespace render {
+    bool setDrawColor(SDL_Renderer* r, Uint8 cr, Uint8 cg, Uint8 cb, Uint8 ca) {
+        renderStats.countColor({ cr, cg, cb, ca });
+        return SDL_SetRenderDrawColor(r, cr, cg, cb, ca);
+    }
+
+    bool fillRect(SDL_Renderer* r, const SDL_FRect* rect) {
+        if (renderStats.active) renderStats.countFill(rect ? area(*rect) : targetArea(r), 4, nullptr);
+        return SDL_RenderFillRect(r, rect);
+    }
+
+    bool rect(SDL_Renderer* r, const SDL_FRect* rect) {
+        if (renderStats.active) renderStats.countFill(rect ? 2.0 * (rect->w + rect->h) : 0.0, 5, nullptr);
+        return SDL_RenderRect(r, rect);
+    }
+
+    bool line(SDL_Renderer* r, float x1, float y1, float x2, float y2) {
+        renderStats.countFill(std::hypot(x2 - x1, y2 - y1) + 1, 2, nullptr);
+        return SDL_RenderLine(r, x1, y1, x2, y2);
+    }
+
+    bool clear(SDL_Renderer* r) {
+        if (renderStats.active) renderStats.countFill(targetArea(r), 4, nullptr);
+        return SDL_RenderClear(r);
+    }
+
+    bool texture(SDL_Renderer* r, SDL_Texture* tex, const SDL_FRect* src, const SDL_FRect* dst) {
+        if (renderStats.active) renderStats.countFill(dst ? area(*dst) : targetArea(r), 4, tex);
+        return SDL_RenderTexture(r, tex, src, dst);
+    }
+
+    bool geometry(SDL_Renderer* r, SDL_Texture* tex, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount) {
+        renderStats.countGeometry(tex, vertices, vertexCount, indices, indexCount);
+        return SDL_RenderGeometry(r, tex, vertices, vertexCount, indices, indexCount);
+    }
+}
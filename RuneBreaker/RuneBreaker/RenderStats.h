@@ -0,0 +1,89 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <fstream>
+#include <string>
+
+// Parts of the game that draw, for attributing renderer work
+enum class RenderSubsystem { OTHER, RUNES, TEXT, PARTICLES, PADDLE, BALL, BRICKS, BATCH, COUNT };
+
+const char* renderSubsystemName(RenderSubsystem s);
+
+// Renderer work done by one subsystem in one frame
+struct RenderCounters {
+    int fills = 0; // primitives drawn, or queued in the rect batch
+    int colorChanges = 0; // SDL_SetRenderDrawColor calls that changed the color
+    int textureBinds = 0; // draws with a different texture from the draw before
+    int vertices = 0;
+    double pixels = 0; // area covered, overdraw included
+};
+
+// Per-frame renderer counters, broken down by subsystem and written as CSV.
+// Direct SDL calls go through the render:: wrappers below and rects queued in
+// the RectBatch are counted as they are queued, both under the subsystem set by
+// the innermost RENDER_SUBSYSTEM. The BATCH row is what the batch then actually
+// submits (SDL_RenderGeometry calls), so it overlaps the rows that queued it.
+// Counting is skipped unless a CSV file is open.
+class RenderStats {
+public:
+    // Start writing one row per subsystem per frame to path
+    bool open(const std::string& path);
+    void close();
+    bool enabled() const { return active; }
+
+    // Write this frame's rows and start counting the next one (call after present)
+    void endFrame();
+
+    // Print per-frame averages for the whole run
+    void logSummary() const;
+
+    // Count work in the current subsystem (called by the wrappers and the RectBatch)
+    void countFill(double pixels, int vertices, SDL_Texture* tex);
+    void countQueued(const SDL_FRect& rect, SDL_Texture* tex);
+    void countGeometry(SDL_Texture* tex, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount);
+    void countColor(SDL_Color c);
+
+    const RenderCounters& counters(RenderSubsystem s) const { return frame[(int)s]; }
+
+    bool active = false;
+    RenderSubsystem current = RenderSubsystem::OTHER;
+
+private:
+    RenderCounters& now() { return frame[(int)current]; }
+    void countBind(SDL_Texture* tex, SDL_Texture*& last);
+
+    std::ofstream file;
+    RenderCounters frame[(int)RenderSubsystem::COUNT];
+    RenderCounters total[(int)RenderSubsystem::COUNT];
+    long long frameIndex = 0;
+    SDL_Color lastColor = { 0, 0, 0, 0 };
+    bool haveColor = false;
+    SDL_Texture* lastBound = nullptr; // texture of the last real draw
+    SDL_Texture* lastQueued = nullptr; // texture of the last quad queued in the batch
+};
+
+extern RenderStats renderStats;
+
+// Attributes renderer work in the enclosing block to a subsystem
+class RenderStatsScope {
+public:
+    explicit RenderStatsScope(RenderSubsystem s) : prev(renderStats.current) { renderStats.current = s; }
+    ~RenderStatsScope() { renderStats.current = prev; }
+    RenderStatsScope(const RenderStatsScope&) = delete;
+    RenderStatsScope& operator=(const RenderStatsScope&) = delete;
+
+private:
+    RenderSubsystem prev;
+};
+
+#define RENDER_SUBSYSTEM(s) RenderStatsScope renderStatsScope(RenderSubsystem::s)
+
+// Counting versions of the SDL renderer calls the game makes directly
+namespace render {
+    bool setDrawColor(SDL_Renderer* r, Uint8 cr, Uint8 cg, Uint8 cb, Uint8 ca);
+    bool fillRect(SDL_Renderer* r, const SDL_FRect* rect);
+    bool rect(SDL_Renderer* r, const SDL_FRect* rect);
+    bool line(SDL_Renderer* r, float x1, float y1, float x2, float y2);
+    bool clear(SDL_Renderer* r);
+    bool texture(SDL_Renderer* r, SDL_Texture* tex, const SDL_FRect* src, const SDL_FRect* dst);
+    bool geometry(SDL_Renderer* r, SDL_Texture* tex, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount);
+}
@@ -0,0 +1,239 @@
+#include "Replay.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+static const char REPLAY_MAGIC[4] = { 'R', 'B', 'R', 'P' };
+static const int REPLAY_VERSION = 3; // 2: run seeds expand into different random streams, 3: wider state hash
+static const uint8_t RECORD_FIELD_SIZE = 0x80;
+static const size_t HEADER_SIZE = 4 + 2 + 2 + 8 + 2 + 2 + 4;
+
+uint8_t packInput(const InputFrame& input, bool pauseKey) {
+    uint8_t keys = 0;
+    if (input.left) keys |= REPLAY_LEFT;
+    if (input.right) keys |= REPLAY_RIGHT;
+    if (input.launch) keys |= REPLAY_SPACE;
+    if (input.skipLevel) keys |= REPLAY_F;
+    if (pauseKey) keys |= REPLAY_P;
+    return keys;
+}
+
+InputFrame unpackInput(uint8_t keys) {
+    InputFrame input;
+    input.left = (keys & REPLAY_LEFT) != 0;
+    input.right = (keys & REPLAY_RIGHT) != 0;
+    input.launch = (keys & REPLAY_SPACE) != 0;
+    input.skipLevel = (keys & REPLAY_F) != 0;
+    return input;
+}
+
+// Fold a state hash into the 16 bits stored per step
+static uint16_t shortHash(uint32_t h) {
+    return (uint16_t)(h ^ (h >> 16));
+}
+
+// ---------- little-endian writing and reading ----------
+static void putBytes(std::vector<uint8_t>& out, uint64_t v, int count) {
+    for (int i = 0; i < count; ++i) out.push_back((uint8_t)(v >> (8 * i)));
+}
+
+static void putVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+static bool getBytes(const std::vector<uint8_t>& in, size_t& pos, int count, uint64_t& v) {
+    if (pos + count > in.size()) return false;
+    v = 0;
+    for (int i = 0; i < count; ++i) v |= (uint64_t)in[pos++] << (8 * i);
+    return true;
+}
+
+static bool getVarint(const std::vector<uint8_t>& in, size_t& pos, uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (pos >= in.size()) return false;
+        uint8_t b = in[pos++];
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static void putRun(std::vector<uint8_t>& out, uint8_t keys, uint32_t length) {
+    if (length == 0) return;
+    out.push_back(keys);
+    putVarint(out, length);
+}
+
+// ---------- recording ----------
+void ReplayRecorder::start(int level, uint64_t seed, float fieldW, float fieldH) {
+    recording = true;
+    startLevel = level;
+    runSeed = seed;
+    startW = lastW = (int)fieldW;
+    startH = lastH = (int)fieldH;
+    runKeys = 0;
+    runLength = 0;
+    records.clear();
+    hashes.clear();
+}
+
+void ReplayRecorder::record(uint8_t keys, float fieldW, float fieldH, uint32_t stateHash) {
+    if (!recording) return;
+
+    // the window was resized before this step
+    int w = (int)fieldW, h = (int)fieldH;
+    if (w != lastW || h != lastH) {
+        putRun(records, runKeys, runLength);
+        runLength = 0;
+        records.push_back(RECORD_FIELD_SIZE);
+        putBytes(records, (uint16_t)w, 2);
+        putBytes(records, (uint16_t)h, 2);
+        lastW = w;
+        lastH = h;
+    }
+
+    if (keys == runKeys && runLength > 0 && runLength < UINT32_MAX) {
+        runLength++;
+    }
+    else {
+        putRun(records, runKeys, runLength);
+        runKeys = keys;
+        runLength = 1;
+    }
+    hashes.push_back(shortHash(stateHash));
+}
+
+bool ReplayRecorder::save(const std::string& path) const {
+    std::vector<uint8_t> out;
+    out.reserve(HEADER_SIZE + records.size() + 8 + hashes.size() * 2);
+    out.insert(out.end(), REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    putBytes(out, REPLAY_VERSION, 2);
+    putBytes(out, (uint16_t)startLevel, 2);
+    putBytes(out, runSeed, 8);
+    putBytes(out, (uint16_t)startW, 2);
+    putBytes(out, (uint16_t)startH, 2);
+    putBytes(out, (uint32_t)hashes.size(), 4);
+    out.insert(out.end(), records.begin(), records.end());
+    putRun(out, runKeys, runLength);
+    for (uint16_t h : hashes) putBytes(out, h, 2);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    file.write((const char*)out.data(), (std::streamsize)out.size());
+    return (bool)file;
+}
+
+// ---------- playback ----------
+bool ReplayPlayer::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << path << ": cannot open replay\n";
+        return false;
+    }
+    std::vector<uint8_t> in((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    size_t pos = 0;
+    uint64_t version = 0, level = 0, seed = 0, w = 0, h = 0, steps = 0;
+    if (in.size() < HEADER_SIZE || !std::equal(REPLAY_MAGIC, REPLAY_MAGIC + 4, in.begin())) {
+        std::cerr << path << ": not a replay file\n";
+        return false;
+    }
+    pos = 4;
+    getBytes(in, pos, 2, version);
+    getBytes(in, pos, 2, level);
+    getBytes(in, pos, 8, seed);
+    getBytes(in, pos, 2, w);
+    getBytes(in, pos, 2, h);
+    getBytes(in, pos, 4, steps);
+    if (version != REPLAY_VERSION) {
+        std::cerr << path << ": unsupported replay version " << version << "\n";
+        return false;
+    }
+    if (level < 1 || level > MAX_LEVELS || w == 0 || h == 0) {
+        std::cerr << path << ": bad replay header\n";
+        return false;
+    }
+
+    // walk the records once so playback can trust them
+    size_t recordStart = pos;
+    uint64_t covered = 0;
+    while (covered < steps) {
+        if (pos >= in.size()) break;
+        uint8_t b = in[pos++];
+        uint64_t size;
+        uint32_t length;
+        if (b == RECORD_FIELD_SIZE) {
+            if (!getBytes(in, pos, 4, size)) break;
+        }
+        else if (b & RECORD_FIELD_SIZE || !getVarint(in, pos, length) || length == 0) {
+            break;
+        }
+        else {
+            covered += length;
+        }
+    }
+    if (covered != steps || in.size() - pos != steps * 2) {
+        std::cerr << path << ": replay is truncated or corrupt\n";
+        return false;
+    }
+
+    startLevel = (int)level;
+    runSeed = seed;
+    startW = (int)w;
+    startH = (int)h;
+    records.assign(in.begin() + recordStart, in.begin() + pos);
+    hashes.resize((size_t)steps);
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        uint64_t v = 0;
+        getBytes(in, pos, 2, v);
+        hashes[i] = (uint16_t)v;
+    }
+    readPos = 0;
+    runLeft = 0;
+    stepIndex = 0;
+    desyncStep = -1;
+    return true;
+}
+
+void ReplayPlayer::begin(GameSim& sim) {
+    readPos = 0;
+    runLeft = 0;
+    stepIndex = 0;
+    desyncStep = -1;
+    sim.setFieldSize((float)startW, (float)startH);
+    sim.reset(startLevel, runSeed);
+}
+
+bool ReplayPlayer::step(GameSim& sim) {
+    if (finished() || desynced()) return false;
+
+    // field size changes come just before the run of keys they apply to
+    while (runLeft == 0) {
+        uint8_t b = records[readPos++];
+        if (b == RECORD_FIELD_SIZE) {
+            uint64_t w = 0, h = 0;
+            getBytes(records, readPos, 2, w);
+            getBytes(records, readPos, 2, h);
+            sim.setFieldSize((float)w, (float)h);
+        }
+        else {
+            runKeys = b;
+            getVarint(records, readPos, runLeft);
+        }
+    }
+
+    sim.step(unpackInput(runKeys), FIXED_DT);
+    runLeft--;
+    if (shortHash(sim.stateHash()) != hashes[stepIndex]) {
+        desyncStep = stepIndex;
+        return false;
+    }
+    stepIndex++;
+    return true;
+}
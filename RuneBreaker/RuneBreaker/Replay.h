@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameSim.h"
+
+// Keys stored for every simulation step of a replay
+enum ReplayKey : uint8_t {
+    REPLAY_LEFT = 1 << 0,
+    REPLAY_RIGHT = 1 << 1,
+    REPLAY_SPACE = 1 << 2,
+    REPLAY_F = 1 << 3,
+    REPLAY_P = 1 << 4, // recorded for completeness, pausing never reaches the simulation
+};
+
+uint8_t packInput(const InputFrame& input, bool pauseKey);
+InputFrame unpackInput(uint8_t keys);
+
+// One game's seed, starting level and per-step keys, with the field size
+// whenever it changes and a 16-bit state hash per step. Keys are stored as
+// runs of identical steps, so a held key costs a few bytes however long it is
+// held. Files are little-endian:
+//   "RBRP" u16 version, u16 level, u64 seed, u16 field w, u16 field h, u32 steps
+//   records: u8 keys + varint run length, or 0x80 + u16 w + u16 h (new field size)
+//   u16 hash for every step
+class ReplayRecorder {
+public:
+    // Begin recording a game that GameSim::reset was just called for
+    void start(int level, uint64_t seed, float fieldW, float fieldH);
+
+    // Record the step the simulation just took with keys, on a field of fieldW x fieldH
+    void record(uint8_t keys, float fieldW, float fieldH, uint32_t stateHash);
+
+    // Write the recording, returns false if the file could not be written
+    bool save(const std::string& path) const;
+
+    // Stop recording (until the next start)
+    void stop() { recording = false; }
+
+    bool active() const { return recording; }
+    int steps() const { return (int)hashes.size(); }
+
+private:
+    bool recording = false;
+    int startLevel = 1;
+    uint64_t runSeed = 0;
+    int startW = 0, startH = 0;
+    int lastW = 0, lastH = 0;
+    uint8_t runKeys = 0;
+    uint32_t runLength = 0;
+    std::vector<uint8_t> records; // finished runs and field sizes
+    std::vector<uint16_t> hashes;
+};
+
+// Feeds a recorded game back into a GameSim, one step at a time
+class ReplayPlayer {
+public:
+    // Read a replay file, returns false (and logs why) if it is missing or malformed
+    bool load(const std::string& path);
+
+    // Reset sim to the recorded seed, level and field size and rewind to the first step
+    void begin(GameSim& sim);
+
+    // Run the next recorded step on sim, then compare the state hash.
+    // Returns false once the replay is over or the simulation has drifted from it.
+    bool step(GameSim& sim);
+
+    bool finished() const { return stepIndex >= (int)hashes.size(); }
+    bool desynced() const { return desyncStep >= 0; }
+    int desyncAt() const { return desyncStep; } // first step whose hash did not match, -1 if none
+    int stepsPlayed() const { return stepIndex; }
+    int stepCount() const { return (int)hashes.size(); }
+    int level() const { return startLevel; }
+    uint64_t seed() const { return runSeed; }
+
+private:
+    int startLevel = 1;
+    uint64_t runSeed = 0;
+    int startW = 0, startH = 0;
+    std::vector<uint8_t> records;
+    std::vector<uint16_t> hashes;
+
+    // playback position
+    size_t readPos = 0;
+    uint8_t runKeys = 0;
+    uint32_t runLeft = 0;
+    int stepIndex = 0;
+    int desyncStep = -1;
+};
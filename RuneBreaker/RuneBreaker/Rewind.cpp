@@ -0,0 +1,143 @@
+#include "Rewind.h"
+#include <cstring>
+
+static void putVarint(std::vector<uint8_t>& out, size_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+// Read a varint from [p, end), returns false if it runs past end
+static bool getVarint(const uint8_t*& p, const uint8_t* end, size_t& v) {
+    v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        uint8_t b = *p++;
+        v |= (size_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+// Encode a ^ b as pairs of (zero bytes to skip, changed bytes that follow) plus the changed bytes
+static void encodeDelta(const uint8_t* a, const uint8_t* b, size_t n, std::vector<uint8_t>& out) {
+    out.clear();
+    size_t i = 0;
+    while (i < n) {
+        size_t zeros = i;
+        while (i < n && a[i] == b[i]) i++;
+        size_t start = i;
+        // a lone matching byte is cheaper to store than to end the literal run for
+        while (i < n && (a[i] != b[i] || (i + 1 < n && a[i + 1] != b[i + 1]))) i++;
+        putVarint(out, start - zeros);
+        putVarint(out, i - start);
+        for (size_t j = start; j < i; ++j) out.push_back(a[j] ^ b[j]);
+    }
+}
+
+// XOR an encoded delta of size bytes into state, which turns either snapshot of the pair into the other.
+// Returns false (with state partly changed) if the delta does not fit the snapshot.
+static bool applyDelta(uint8_t* state, const uint8_t* p, size_t size) {
+    const uint8_t* end = p + size;
+    size_t pos = 0;
+    while (pos < sizeof(SimSnapshot)) {
+        size_t skip, literals;
+        if (!getVarint(p, end, skip) || skip > sizeof(SimSnapshot) - pos) return false;
+        pos += skip;
+        if (!getVarint(p, end, literals) || literals > sizeof(SimSnapshot) - pos || literals > (size_t)(end - p)) return false;
+        for (size_t j = 0; j < literals; ++j) state[pos++] ^= *p++;
+    }
+    return p == end;
+}
+
+void RewindBuffer::init(float seconds, size_t maxBytes) {
+    maxSteps = seconds > 0 ? (int)(seconds / FIXED_DT) : 0;
+    entries.assign(maxSteps, Entry{ 0, 0 });
+    ring.assign(maxSteps > 0 ? maxBytes : 0, 0);
+    if (maxSteps > 0) {
+        latest = std::make_unique<SimSnapshot>();
+        scratch = std::make_unique<SimSnapshot>();
+        // zeroed once so the first delta starts from known bytes. After that the array
+        // tails past ballCount/powerupCount are not zero: saveSnapshot leaves whatever
+        // the last longer state wrote there. They stay out of the deltas only because
+        // scratch is copied into latest on every push, so both sides hold the same
+        // stale bytes (deltas are exact, so a tail that does differ just costs space)
+        std::memset((void*)latest.get(), 0, sizeof(SimSnapshot));
+        std::memset((void*)scratch.get(), 0, sizeof(SimSnapshot));
+    }
+    clear();
+}
+
+void RewindBuffer::clear() {
+    first = 0;
+    count = 0;
+    writePos = 0;
+    usedBytes = 0;
+    haveLatest = false;
+}
+
+void RewindBuffer::dropOldest() {
+    usedBytes -= entries[first].size;
+    first = (first + 1) % maxSteps;
+    count--;
+}
+
+void RewindBuffer::push(const GameSim& sim) {
+    if (!enabled()) return;
+    sim.saveSnapshot(*scratch);
+    if (!haveLatest) {
+        std::memcpy(latest.get(), scratch.get(), sizeof(SimSnapshot));
+        haveLatest = true;
+        return;
+    }
+
+    encodeDelta((const uint8_t*)latest.get(), (const uint8_t*)scratch.get(), sizeof(SimSnapshot), encoded);
+    std::memcpy(latest.get(), scratch.get(), sizeof(SimSnapshot));
+    if (encoded.size() > ring.size()) {
+        // a single step that changes this much cannot be stepped back over
+        count = 0;
+        usedBytes = 0;
+        return;
+    }
+
+    // deltas are stored whole, so one that would run off the end starts over at the front.
+    // The oldest deltas sit between writePos and the end of the ring, and that tail is
+    // given up, so they go first; after that the oldest delta is always the lowest one.
+    if (writePos + encoded.size() > ring.size()) {
+        while (count > 0 && entries[first].offset >= writePos) dropOldest();
+        writePos = 0;
+    }
+    size_t begin = writePos, end = writePos + encoded.size();
+    while (count > 0) {
+        const Entry& oldest = entries[first];
+        bool overlaps = oldest.offset < end && begin < oldest.offset + oldest.size;
+        if (!overlaps && count < maxSteps) break;
+        dropOldest();
+    }
+
+    std::memcpy(ring.data() + begin, encoded.data(), encoded.size());
+    entries[(first + count) % maxSteps] = { begin, encoded.size() };
+    count++;
+    usedBytes += encoded.size();
+    writePos = end;
+}
+
+int RewindBuffer::rewind(GameSim& sim, int steps) {
+    if (!enabled() || !haveLatest) return 0;
+    int done = 0;
+    while (done < steps && count > 0) {
+        const Entry& newest = entries[(first + count - 1) % maxSteps];
+        if (!applyDelta((uint8_t*)latest.get(), ring.data() + newest.offset, newest.size)) {
+            // a damaged delta leaves latest unusable, so sim stays put and the history starts over
+            clear();
+            return 0;
+        }
+        writePos = newest.offset;
+        usedBytes -= newest.size;
+        count--;
+        done++;
+    }
+    if (done > 0) sim.loadSnapshot(*latest);
+    return done;
+}
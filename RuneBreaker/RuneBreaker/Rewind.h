@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "GameSim.h"
+
+// The last few seconds of a game, one SimSnapshot per simulation step, so
+// play can be scrubbed backwards.
+// Only the newest snapshot is kept whole. Every older step is stored as the
+// XOR of its snapshot with the one after it, with runs of zero bytes (the
+// parts that did not change) squeezed out. Stepping back XORs the newest
+// delta into the whole snapshot, which undoes it exactly. The deltas share
+// one fixed byte ring, and the oldest ones are dropped when it fills up.
+class RewindBuffer {
+public:
+    // Keep up to seconds of steps in at most maxBytes of deltas
+    void init(float seconds, size_t maxBytes = 8 * 1024 * 1024);
+
+    // Forget everything (call when a new game starts)
+    void clear();
+
+    // Remember the state the simulation is in now (after each step)
+    void push(const GameSim& sim);
+
+    // Put sim back up to steps steps, returns how many it went back (0 when nothing is left)
+    int rewind(GameSim& sim, int steps = 1);
+
+    bool enabled() const { return maxSteps > 0; }
+    int stepsStored() const { return count; }
+    size_t bytesUsed() const { return usedBytes; }
+
+private:
+    struct Entry {
+        size_t offset;
+        size_t size;
+    };
+
+    void dropOldest();
+
+    int maxSteps = 0;
+    std::vector<uint8_t> ring; // encoded deltas
+    std::vector<Entry> entries; // ring of deltas, oldest at first
+    int first = 0, count = 0;
+    size_t writePos = 0, usedBytes = 0;
+
+    std::unique_ptr<SimSnapshot> latest; // the newest state, whole
+    std::unique_ptr<SimSnapshot> scratch;
+    bool haveLatest = false;
+    std::vector<uint8_t> encoded;
+};
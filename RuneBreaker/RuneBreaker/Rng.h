@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+
+// Independent random streams derived from one run seed. Gameplay draws from
+// its own streams so cosmetic effects can use as many numbers as they like
+// without changing the level layouts or power-up drops of a seed.
+enum class RngStream : uint32_t { LEVEL = 1, DROPS = 2, COSMETIC = 3, AUTOPLAY = 4 };
+
+// xoshiro128** generator: 16 bytes of state, one instance per user, no globals
+class Rng {
+public:
+    Rng() { seed(0, RngStream::COSMETIC); }
+    Rng(uint64_t runSeed, RngStream stream) { seed(runSeed, stream); }
+
+    // Restart the stream, expanding the seed with splitmix64 so nearby seeds diverge.
+    // The stream is hashed into the starting point rather than added as a multiple of the
+    // splitmix increment, so no two (seed, stream) pairs walk the same splitmix sequence.
+    void seed(uint64_t runSeed, RngStream stream) {
+        uint64_t x = mix64(runSeed ^ mix64((uint64_t)stream));
+        for (int i = 0; i < 4; i += 2) {
+            uint64_t z = splitmix64(x);
+            s[i] = (uint32_t)z;
+            s[i + 1] = (uint32_t)(z >> 32);
+        }
+    }
+
+    uint32_t next() {
+        uint32_t result = rotl(s[1] * 5, 7) * 9;
+        uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 11);
+        return result;
+    }
+
+    // Uniform integer in [0, n)
+    int range(int n) { return (int)(((uint64_t)next() * (uint32_t)n) >> 32); }
+
+    // Uniform float in [0, 1)
+    float unit() { return (next() >> 8) * (1.0f / 16777216.0f); }
+
+private:
+    static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    // splitmix64 output function
+    static uint64_t mix64(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    static uint64_t splitmix64(uint64_t& x) {
+        return mix64(x += 0x9E3779B97F4A7C15ull);
+    }
+
+    uint32_t s[4];
+};
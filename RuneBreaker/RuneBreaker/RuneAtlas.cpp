@@ -0,0 +1,213 @@
+#include "RuneAtlas.h"
+#include "RectBatch.h"
+#include "RenderStats.h"
+#include <algorithm>
+#include <cmath>
+
+// ---------- rune system ----------
+const uint16_t RUNE_PATTERNS[][12] = {
+    // Rune 0: triangle with inner circle
+    {0b000001100000, 0b000011110000, 0b000110011000, 0b001100001100,
+     0b001100001100, 0b011001110110, 0b011001110110, 0b110011111011,
+     0b110011111011, 0b110000000011, 0b111111111111, 0b111111111111},
+
+     // Rune 1: diamond with cross
+     {0b000001100000, 0b000011110000, 0b000111111000, 0b001111111100,
+      0b011100001110, 0b111000000111, 0b111000000111, 0b011100001110,
+      0b001111111100, 0b000111111000, 0b000011110000, 0b000001100000},
+
+      // Rune 2: vertical with wings
+      {0b000001100000, 0b000001100000, 0b001101101100, 0b011101101110,
+       0b111001100111, 0b000001100000, 0b000001100000, 0b000001100000,
+       0b000001100000, 0b011001100110, 0b001101101100, 0b000111111000},
+
+       // Rune 3: star pattern
+       {0b000001100000, 0b000111111000, 0b001101101100, 0b011000000110,
+        0b111000000111, 0b011001100110, 0b011001100110, 0b111000000111,
+        0b011000000110, 0b001101101100, 0b000111111000, 0b000001100000},
+
+        // Rune 4: eye shape
+        {0b000111111000, 0b011111111110, 0b111100001111, 0b111001110111,
+         0b110011111011, 0b110011111011, 0b110011111011, 0b110011111011,
+         0b111001110111, 0b111100001111, 0b011111111110, 0b000111111000}
+};
+
+// Render a rune symbol
+void rasterizeRune(SDL_Renderer* r, float x, float y, float w, float h, int runeType, SDL_Color color, float glowIntensity) {
+    RENDER_SUBSYSTEM(RUNES);
+    // draw outer glow layers
+    if (glowIntensity > 0) {
+        for (int i = 3; i >= 0; --i) {
+            Uint8 alpha = (Uint8)(glowIntensity * 60 * (i + 1));
+            render::setDrawColor(r, color.r, color.g, color.b, alpha);
+            SDL_FRect glow = { x - i * 2, y - i * 2, w + i * 4, h + i * 4 };
+            render::fillRect(r, &glow);
+        }
+    }
+
+    // draw dark background
+    render::setDrawColor(r, color.r / 3, color.g / 3, color.b / 3, 255);
+    SDL_FRect bgRect = { x, y, w, h };
+    render::fillRect(r, &bgRect);
+
+    // select rune pattern and calculate pixel size
+    int pattern = runeType % 5;
+    float runeSize = std::min(w - 4, h - 2);
+    float offsetX = x + (w - runeSize) / 2;
+    float offsetY = y + (h - runeSize) / 2;
+    float pixelSize = runeSize / 12.0f;
+
+    // render rune
+    for (int row = 0; row < 12; ++row) {
+        uint16_t line = RUNE_PATTERNS[pattern][row];
+        for (int col = 0; col < 12; ++col) {
+            if (line & (1 << (11 - col))) {
+                // brighten pixels when glowing
+                Uint8 r_val = std::min(255, (int)(color.r + glowIntensity * 100));
+                Uint8 g_val = std::min(255, (int)(color.g + glowIntensity * 100));
+                Uint8 b_val = std::min(255, (int)(color.b + glowIntensity * 100));
+                render::setDrawColor(r, r_val, g_val, b_val, 255);
+
+                SDL_FRect pixel = { offsetX + col * pixelSize, offsetY + row * pixelSize, pixelSize + 1, pixelSize + 1 };
+                render::fillRect(r, &pixel);
+            }
+        }
+    }
+
+    // draw border
+    render::setDrawColor(r, color.r / 2, color.g / 2, color.b / 2, 255);
+    render::rect(r, &bgRect);
+}
+
+// Quantize glow so nearby intensities share a baked cell (any glow at all keeps its halo)
+static int glowBucket(float glow) {
+    if (glow <= 0) return 0;
+    return std::clamp((int)std::lround(glow * RUNE_GLOW_BUCKETS), 1, RUNE_GLOW_BUCKETS);
+}
+
+// Pack pattern, color and glow bucket into one cache key
+static uint64_t runeKey(int pattern, SDL_Color c, int bucket) {
+    return ((uint64_t)pattern << 40) | ((uint64_t)bucket << 32) |
+        ((uint64_t)c.r << 24) | ((uint64_t)c.g << 16) | ((uint64_t)c.b << 8) | (uint64_t)c.a;
+}
+
+// Brick sizes are fractional, so key them in 1/16 px steps
+static int sizeKey(float w, float h) {
+    return ((int)std::lround(w * 16) << 16) | ((int)std::lround(h * 16) & 0xFFFF);
+}
+
+void RuneAtlas::clear() {
+    for (auto& p : pages) {
+        if (p.texture) SDL_DestroyTexture(p.texture);
+    }
+    pages.clear();
+}
+
+// Find the page for a brick size, creating it (and evicting the oldest size) if needed
+RuneAtlas::Page* RuneAtlas::findPage(SDL_Renderer* r, float w, float h) {
+    int key = sizeKey(w, h);
+    for (auto& p : pages) {
+        if (p.sizeKey == key) return &p;
+    }
+
+    // evict least recently used size
+    if ((int)pages.size() >= MAX_SIZES) {
+        auto oldest = std::min_element(pages.begin(), pages.end(),
+            [](const Page& a, const Page& b) { return a.lastUsed < b.lastUsed; });
+        // this frame may already have queued bricks from it
+        if (oldest->texture) rectBatch.destroyAfterFlush(oldest->texture);
+        pages.erase(oldest);
+    }
+
+    // enough cells for every pattern/glow combination of the four hit colors
+    // (any more keys than that wrap the page around, see bakeCell)
+    const int slotCount = 5 * 4 * (RUNE_GLOW_BUCKETS + 1);
+
+    Page page;
+    page.sizeKey = key;
+    page.w = w;
+    page.h = h;
+    page.cellW = (int)std::ceil(w) + GLOW_MARGIN * 2;
+    page.cellH = (int)std::ceil(h) + GLOW_MARGIN * 2;
+    page.cols = std::max(1, std::min(slotCount, MAX_TEXTURE_W / page.cellW));
+    page.rows = (slotCount + page.cols - 1) / page.cols;
+    page.texture = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+        page.cols * page.cellW, page.rows * page.cellH);
+    if (!page.texture) return nullptr;
+    SDL_SetTextureScaleMode(page.texture, SDL_SCALEMODE_NEAREST);
+    // the renderer draws with BLENDMODE_NONE, so a baked cell must overwrite the screen the same way
+    SDL_SetTextureBlendMode(page.texture, SDL_BLENDMODE_NONE);
+
+    pages.push_back(std::move(page));
+    return &pages.back();
+}
+
+// Render one rune into a free cell of the page, returns the cell index
+int RuneAtlas::bakeCell(SDL_Renderer* r, Page& page, uint64_t key, int pattern, SDL_Color color, float glow) {
+    // page full - start over rather than grow. Quads queued earlier this frame may
+    // still point at the cells about to be overwritten, so draw them first.
+    if ((int)page.slots.size() >= page.cols * page.rows) {
+        rectBatch.drawQueued(r);
+        page.slots.clear();
+    }
+
+    int cell = (int)page.slots.size();
+    float cellX = (float)((cell % page.cols) * page.cellW);
+    float cellY = (float)((cell / page.cols) * page.cellH);
+
+    SDL_Texture* prevTarget = SDL_GetRenderTarget(r);
+    SDL_BlendMode prevBlend;
+    SDL_GetRenderDrawBlendMode(r, &prevBlend);
+
+    SDL_SetRenderTarget(r, page.texture);
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+    render::setDrawColor(r, 0, 0, 0, 0);
+    SDL_FRect cellRect = { cellX, cellY, (float)page.cellW, (float)page.cellH };
+    render::fillRect(r, &cellRect);
+    rasterizeRune(r, cellX + GLOW_MARGIN, cellY + GLOW_MARGIN, page.w, page.h, pattern, color, glow);
+
+    SDL_SetRenderTarget(r, prevTarget);
+    SDL_SetRenderDrawBlendMode(r, prevBlend);
+
+    page.slots[key] = cell;
+    return cell;
+}
+
+bool RuneAtlas::lookup(SDL_Renderer* r, float x, float y, float w, float h, int runeType, SDL_Color color, float glowIntensity,
+    SDL_Texture** tex, SDL_FRect* src, SDL_FRect* dst) {
+    Page* page = findPage(r, w, h);
+    if (!page) return false;
+    page->lastUsed = ++useClock;
+
+    int pattern = runeType % 5;
+    int bucket = glowBucket(glowIntensity);
+    uint64_t key = runeKey(pattern, color, bucket);
+
+    int cell;
+    auto it = page->slots.find(key);
+    if (it != page->slots.end()) cell = it->second;
+    else cell = bakeCell(r, *page, key, pattern, color, bucket / (float)RUNE_GLOW_BUCKETS);
+
+    float cellX = (float)((cell % page->cols) * page->cellW) + GLOW_MARGIN;
+    float cellY = (float)((cell / page->cols) * page->cellH) + GLOW_MARGIN;
+
+    // glowing cells include the halo around the brick
+    float m = bucket > 0 ? (float)GLOW_MARGIN : 0.0f;
+    *tex = page->texture;
+    *src = { cellX - m, cellY - m, page->w + m * 2, page->h + m * 2 };
+    *dst = { x - m, y - m, w + m * 2, h + m * 2 };
+    return true;
+}
+
+// Render a rune symbol
+void drawRune(SDL_Renderer* r, float x, float y, float w, float h, int runeType, SDL_Color color, float glowIntensity) {
+    RENDER_SUBSYSTEM(RUNES);
+    SDL_Texture* tex;
+    SDL_FRect src, dst;
+    if (runeAtlas.lookup(r, x, y, w, h, runeType, color, glowIntensity, &tex, &src, &dst)) {
+        rectBatch.texture(tex, src, dst);
+    }
+    else {
+        rasterizeRune(r, x, y, w, h, runeType, color, glowIntensity);
+    }
+}
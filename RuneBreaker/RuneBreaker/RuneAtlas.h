@@ -0,0 +1,52 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// number of distinct glow levels baked per rune (0 = no glow)
+const int RUNE_GLOW_BUCKETS = 16;
+
+// Draw a rune brick through the atlas into the frame batch
+void drawRune(SDL_Renderer* r, float x, float y, float w, float h, int runeType, SDL_Color color, float glowIntensity = 0);
+
+// Draw a rune brick straight to the renderer, one rect per rune pixel
+void rasterizeRune(SDL_Renderer* r, float x, float y, float w, float h, int runeType, SDL_Color color, float glowIntensity = 0);
+
+// Texture cache of pre-rendered rune bricks.
+// Each brick size gets its own page texture; every (pattern, color, glow bucket)
+// combination is baked into a cell the first time it is drawn, after which a
+// brick costs a single textured quad. Only the most recently used sizes are kept.
+class RuneAtlas {
+public:
+    // Destroy all page textures (call before the renderer is destroyed or after a device reset)
+    void clear();
+
+    // Look up (baking if needed) the page texture and source rect for a rune.
+    // dst is the area the returned src covers on screen, including the glow halo.
+    bool lookup(SDL_Renderer* r, float x, float y, float w, float h, int runeType, SDL_Color color, float glowIntensity,
+        SDL_Texture** tex, SDL_FRect* src, SDL_FRect* dst);
+
+private:
+    static const int MAX_SIZES = 4; // brick sizes kept before the oldest is evicted
+    static const int GLOW_MARGIN = 6; // outermost glow layer extends this far past the brick
+    static const int MAX_TEXTURE_W = 2048;
+
+    struct Page {
+        int sizeKey = 0; // quantized brick size
+        float w = 0, h = 0; // brick size the cells were baked at
+        SDL_Texture* texture = nullptr;
+        int cellW = 0, cellH = 0, cols = 0, rows = 0;
+        std::unordered_map<uint64_t, int> slots; // cell index per rune key
+        uint64_t lastUsed = 0;
+    };
+
+    Page* findPage(SDL_Renderer* r, float w, float h);
+    int bakeCell(SDL_Renderer* r, Page& page, uint64_t key, int pattern, SDL_Color color, float glow);
+
+    std::vector<Page> pages;
+    uint64_t useClock = 0;
+};
+
+// the shared atlas (defined in Main.cpp)
+extern RuneAtlas runeAtlas;
@@ -0,0 +1,154 @@
+#include "SaveGame.h"
+#include <fstream>
+
+static const char SAVE_MAGIC[4] = { 'R', 'B', 'S', 'V' };
+static const int SAVE_VERSION = 1;
+static const size_t SAVE_HEADER_SIZE = 4 + 2 + 2 + 4 + 4;
+
+static void putU32(std::vector<Uint8>& out, Uint32 v) {
+    for (int i = 0; i < 4; ++i) out.push_back((Uint8)(v >> (8 * i)));
+}
+
+static Uint32 getU32(const Uint8* p) {
+    return (Uint32)p[0] | ((Uint32)p[1] << 8) | ((Uint32)p[2] << 16) | ((Uint32)p[3] << 24);
+}
+
+// Header and payload for data, ready to write
+static void encodeSave(const SaveData& data, std::vector<Uint8>& out) {
+    std::vector<Uint8> payload;
+    putU32(payload, (Uint32)data.highScore);
+    putU32(payload, (Uint32)data.unlockedLevel);
+
+    out.clear();
+    out.insert(out.end(), SAVE_MAGIC, SAVE_MAGIC + 4);
+    out.push_back((Uint8)SAVE_VERSION);
+    out.push_back((Uint8)(SAVE_VERSION >> 8));
+    out.push_back(0);
+    out.push_back(0);
+    putU32(out, (Uint32)payload.size());
+    putU32(out, SDL_crc32(0, payload.data(), payload.size()));
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+// Check the header and CRC and read the fields this version knows about
+static bool decodeSave(const Uint8* bytes, size_t size, SaveData& data) {
+    if (size < SAVE_HEADER_SIZE || SDL_memcmp(bytes, SAVE_MAGIC, 4) != 0) return false;
+    int version = bytes[4] | (bytes[5] << 8);
+    Uint32 payloadSize = getU32(bytes + 8);
+    Uint32 crc = getU32(bytes + 12);
+    const Uint8* payload = bytes + SAVE_HEADER_SIZE;
+    if (version < 1 || version > SAVE_VERSION || payloadSize != size - SAVE_HEADER_SIZE) return false;
+    if (SDL_crc32(0, payload, payloadSize) != crc) return false;
+    if (payloadSize < 8) return false;
+
+    data.highScore = (int)getU32(payload);
+    data.unlockedLevel = (int)getU32(payload + 4);
+    return true;
+}
+
+std::string prefDirectory() {
+    char* prefPath = SDL_GetPrefPath("RuneBreaker", "RuneBreaker");
+    std::string dir = prefPath ? prefPath : "";
+    SDL_free(prefPath);
+    return dir;
+}
+
+bool SaveSystem::init() {
+    savePath = prefDirectory() + "save.bin";
+    tempPath = savePath + ".tmp";
+
+    queue = SDL_CreateAsyncIOQueue();
+    if (!queue) {
+        SDL_Log("Async I/O unavailable (%s), progress will not be saved", SDL_GetError());
+        return false;
+    }
+    return true;
+}
+
+void SaveSystem::shutdown() {
+    if (!queue) return;
+    // let the last save land before the queue goes away
+    SDL_AsyncIOOutcome outcome;
+    while ((stage != Stage::IDLE || pending) && SDL_WaitAsyncIOResult(queue, &outcome, 2000)) {
+        handle(outcome);
+    }
+    SDL_DestroyAsyncIOQueue(queue);
+    queue = nullptr;
+}
+
+bool SaveSystem::load(SaveData& data) {
+    size_t size = 0;
+    Uint8* bytes = (Uint8*)SDL_LoadFile(savePath.c_str(), &size);
+    if (bytes) {
+        SaveData loaded;
+        bool ok = decodeSave(bytes, size, loaded);
+        SDL_free(bytes);
+        if (ok) {
+            data = loaded;
+            return true;
+        }
+        SDL_Log("Ignoring damaged save %s", savePath.c_str());
+    }
+
+    // high score from versions that kept it in a text file next to the game
+    std::ifstream legacy("runebreaker_save.txt");
+    int score = 0;
+    if (legacy >> score) {
+        data.highScore = score;
+        return true;
+    }
+    return false;
+}
+
+void SaveSystem::save(const SaveData& data) {
+    if (!queue) return;
+    pendingData = data;
+    pending = true;
+    if (stage == Stage::IDLE) startWrite();
+}
+
+void SaveSystem::startWrite() {
+    pending = false;
+    encodeSave(pendingData, buffer);
+    file = SDL_AsyncIOFromFile(tempPath.c_str(), "w");
+    if (!file) {
+        SDL_Log("Could not save to %s (%s)", tempPath.c_str(), SDL_GetError());
+        return;
+    }
+    writeFailed = false;
+    if (!SDL_WriteAsyncIO(file, buffer.data(), 0, buffer.size(), queue, nullptr)) {
+        writeFailed = true;
+        SDL_CloseAsyncIO(file, false, queue, nullptr);
+        stage = Stage::CLOSING;
+        return;
+    }
+    stage = Stage::WRITING;
+}
+
+void SaveSystem::update() {
+    if (!queue) return;
+    SDL_AsyncIOOutcome outcome;
+    while (SDL_GetAsyncIOResult(queue, &outcome)) handle(outcome);
+}
+
+void SaveSystem::handle(const SDL_AsyncIOOutcome& outcome) {
+    if (stage == Stage::WRITING && outcome.type == SDL_ASYNCIO_TASK_WRITE) {
+        writeFailed = outcome.result != SDL_ASYNCIO_COMPLETE || outcome.bytes_transferred != buffer.size();
+        // flush so the data is on disk before the rename makes it the real save
+        SDL_CloseAsyncIO(file, !writeFailed, queue, nullptr);
+        stage = Stage::CLOSING;
+        return;
+    }
+    if (stage == Stage::CLOSING && outcome.type == SDL_ASYNCIO_TASK_CLOSE) {
+        file = nullptr;
+        stage = Stage::IDLE;
+        if (writeFailed || outcome.result != SDL_ASYNCIO_COMPLETE) {
+            SDL_Log("Could not write %s", tempPath.c_str());
+            SDL_RemovePath(tempPath.c_str());
+        }
+        else if (!SDL_RenamePath(tempPath.c_str(), savePath.c_str())) {
+            SDL_Log("Could not replace %s (%s)", savePath.c_str(), SDL_GetError());
+        }
+        if (pending) startWrite();
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+// SDL's per-user directory for the game's files (ends in a separator, empty if unavailable)
+std::string prefDirectory();
+
+// Progress kept between runs
+struct SaveData {
+    int highScore = 0;
+    int unlockedLevel = 1;
+};
+
+// Versioned binary save file in the user's pref directory.
+// Layout (little-endian): "RBSV", u16 version, u16 reserved, u32 payload size,
+// u32 CRC-32 of the payload, then the payload (i32 high score, i32 unlocked
+// level). Saves are written to a temp file by SDL's async I/O thread, flushed,
+// and only then renamed over the real file, so a crash mid-write leaves the
+// previous save intact and the frame never waits on the disk.
+class SaveSystem {
+public:
+    // Find the save directory and create the I/O queue
+    bool init();
+
+    // Wait for writes still in flight and release the queue
+    void shutdown();
+
+    // Read the save (synchronously, at startup). Falls back to the old text high
+    // score file when there is no save yet; returns false if nothing was found.
+    bool load(SaveData& data);
+
+    // Queue data to be written; saves made while one is in flight are merged into the next write
+    void save(const SaveData& data);
+
+    // Handle finished I/O (call once a frame)
+    void update();
+
+    const std::string& path() const { return savePath; }
+
+private:
+    enum class Stage { IDLE, WRITING, CLOSING };
+
+    void startWrite();
+    void handle(const SDL_AsyncIOOutcome& outcome);
+
+    std::string savePath, tempPath;
+    SDL_AsyncIOQueue* queue = nullptr;
+    SDL_AsyncIO* file = nullptr;
+    Stage stage = Stage::IDLE;
+    bool writeFailed = false;
+    bool pending = false; // a newer save is waiting for the current write to finish
+    SaveData pendingData;
+    std::vector<Uint8> buffer; // bytes being written, must live until the write completes
+};
@@ -0,0 +1,222 @@
+#include "UiText.h"
+#include "RectBatch.h"
+#include "RenderStats.h"
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+namespace ui {
+    //font bitmaps for all characters
+    static const uint8_t FONT5x7[][7] = {
+        {0x00,0x00,0x00,0x00,0x00,0x00,0x00},{0x1E,0x11,0x13,0x15,0x19,0x11,0x1E},
+        {0x04,0x0C,0x14,0x04,0x04,0x04,0x1F},{0x1E,0x11,0x01,0x06,0x08,0x10,0x1F},
+        {0x1E,0x11,0x01,0x06,0x01,0x11,0x1E},{0x02,0x06,0x0A,0x12,0x1F,0x02,0x02},
+        {0x1F,0x10,0x1E,0x01,0x01,0x11,0x1E},{0x0E,0x10,0x1E,0x11,0x11,0x11,0x0E},
+        {0x1F,0x01,0x02,0x04,0x08,0x08,0x08},{0x0E,0x11,0x11,0x0E,0x11,0x11,0x0E},
+        {0x0E,0x11,0x11,0x0F,0x01,0x01,0x0E},{0x0E,0x11,0x11,0x1F,0x11,0x11,0x11},
+        {0x1E,0x11,0x11,0x1E,0x11,0x11,0x1E},{0x0E,0x11,0x10,0x10,0x10,0x11,0x0E},
+        {0x1C,0x12,0x11,0x11,0x11,0x12,0x1C},{0x1F,0x10,0x10,0x1E,0x10,0x10,0x1F},
+        {0x1F,0x10,0x10,0x1E,0x10,0x10,0x10},{0x0E,0x11,0x10,0x17,0x11,0x11,0x0E},
+        {0x11,0x11,0x11,0x1F,0x11,0x11,0x11},{0x1F,0x04,0x04,0x04,0x04,0x04,0x1F},
+        {0x1F,0x02,0x02,0x02,0x12,0x12,0x0C},{0x11,0x12,0x14,0x18,0x14,0x12,0x11},
+        {0x10,0x10,0x10,0x10,0x10,0x10,0x1F},{0x11,0x1B,0x15,0x11,0x11,0x11,0x11},
+        {0x11,0x19,0x15,0x13,0x11,0x11,0x11},{0x0E,0x11,0x11,0x11,0x11,0x11,0x0E},
+        {0x1E,0x11,0x11,0x1E,0x10,0x10,0x10},{0x0E,0x11,0x11,0x11,0x15,0x12,0x0D},
+        {0x1E,0x11,0x11,0x1E,0x14,0x12,0x11},{0x0F,0x10,0x10,0x0E,0x01,0x01,0x1E},
+        {0x1F,0x04,0x04,0x04,0x04,0x04,0x04},{0x11,0x11,0x11,0x11,0x11,0x11,0x0E},
+        {0x11,0x11,0x11,0x11,0x0A,0x0A,0x04},{0x11,0x11,0x11,0x15,0x15,0x1B,0x11},
+        {0x11,0x11,0x0A,0x04,0x0A,0x11,0x11},{0x11,0x11,0x0A,0x04,0x04,0x04,0x04},
+        {0x1F,0x01,0x02,0x04,0x08,0x10,0x1F},{0x00,0x04,0x00,0x00,0x00,0x04,0x00},
+        {0x01,0x01,0x02,0x04,0x08,0x10,0x10},{0x11,0x09,0x02,0x04,0x08,0x12,0x11},
+        {0x00,0x00,0x00,0x1F,0x00,0x00,0x00},{0x00,0x04,0x04,0x1F,0x04,0x04,0x00},
+        {0x04,0x0A,0x11,0x00,0x00,0x00,0x00},{0x00,0x00,0x00,0x00,0x11,0x0A,0x04},
+        {0x00,0x00,0x00,0x00,0x00,0x0C,0x0C}
+    };
+    static const int GLYPH_COUNT = sizeof(FONT5x7) / sizeof(FONT5x7[0]);
+
+    static const int MAX_SCALE = 8; // largest scale with its own glyph atlas
+    static const int MAX_RUNS = 128; // cached strings before the least recently used is dropped
+
+    // A cached string rendered white at one scale
+    struct TextRun {
+        SDL_Texture* texture = nullptr;
+        float w = 0, h = 0;
+        uint64_t lastUsed = 0;
+    };
+
+    static SDL_Texture* glyphAtlas[MAX_SCALE + 1] = {};
+    static std::unordered_map<std::string, TextRun> runCache;
+    static uint64_t runClock = 0;
+
+    // Map character to font index
+    static int glyphIndex(char ch) {
+        if (ch == ' ') return 0;
+        if (ch >= '0' && ch <= '9') return 1 + (ch - '0');
+        if (ch >= 'A' && ch <= 'Z') return 11 + (ch - 'A');
+        if (ch >= 'a' && ch <= 'z') return 11 + (ch - 'a');
+        if (ch == ':') return 37;
+        if (ch == '/') return 38;
+        if (ch == '%') return 39;
+        if (ch == '-') return 40;
+        if (ch == '+') return 41;
+        if (ch == 'x' || ch == 'X') return 34;
+        if (ch == '^') return 42;
+        if (ch == 'v') return 43;
+        if (ch == '.') return 44;
+        return 0;
+    }
+
+    // The draw color alpha was never blended (the renderer draws with BLENDMODE_NONE),
+    // so tint opaque and let the texture alpha cut out the unlit pixels
+    static SDL_Color tint(SDL_Color c) {
+        return { c.r, c.g, c.b, 255 };
+    }
+
+    // Draw single character as one rect per lit pixel (used when textures are unavailable)
+    static void drawCharRects(float x, float y, char ch, SDL_Color c, int s) {
+        int idx = glyphIndex(ch);
+        for (int row = 0; row < 7; ++row) {
+            uint8_t line = FONT5x7[idx][row];
+            for (int col = 0; col < 5; ++col)
+                if (line & (1 << (4 - col))) {
+                    SDL_FRect px = { x + col * s, y + row * s, (float)s, (float)s };
+                    rectBatch.fillRect(px, c);
+                }
+        }
+    }
+
+    // Build (once) the white glyph atlas for a scale: every glyph in one row, 6*s apart
+    static SDL_Texture* getGlyphAtlas(SDL_Renderer* r, int s) {
+        if (s < 1 || s > MAX_SCALE) return nullptr;
+        if (glyphAtlas[s]) return glyphAtlas[s];
+
+        int w = GLYPH_COUNT * 6 * s, h = 7 * s;
+        SDL_Surface* surface = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_RGBA32);
+        if (!surface) return nullptr;
+        SDL_ClearSurface(surface, 0, 0, 0, 0);
+        Uint32 lit = SDL_MapSurfaceRGBA(surface, 255, 255, 255, 255);
+        for (int g = 0; g < GLYPH_COUNT; ++g) {
+            for (int row = 0; row < 7; ++row) {
+                uint8_t line = FONT5x7[g][row];
+                for (int col = 0; col < 5; ++col)
+                    if (line & (1 << (4 - col))) {
+                        SDL_Rect px = { g * 6 * s + col * s, row * s, s, s };
+                        SDL_FillSurfaceRect(surface, &px, lit);
+                    }
+            }
+        }
+
+        glyphAtlas[s] = SDL_CreateTextureFromSurface(r, surface);
+        SDL_DestroySurface(surface);
+        if (glyphAtlas[s]) {
+            SDL_SetTextureScaleMode(glyphAtlas[s], SDL_SCALEMODE_NEAREST);
+            SDL_SetTextureBlendMode(glyphAtlas[s], SDL_BLENDMODE_BLEND);
+        }
+        return glyphAtlas[s];
+    }
+
+    // Source rect of a glyph in its atlas
+    static SDL_FRect glyphRect(char ch, int s) {
+        return { (float)(glyphIndex(ch) * 6 * s), 0, (float)(5 * s), (float)(7 * s) };
+    }
+
+    // Find or render the cached run for a string at a scale
+    static TextRun* getTextRun(SDL_Renderer* r, const std::string& t, int s) {
+        std::string key = std::to_string(s) + '\x1f' + t;
+        auto it = runCache.find(key);
+        if (it != runCache.end()) {
+            it->second.lastUsed = ++runClock;
+            return &it->second;
+        }
+
+        SDL_Texture* atlas = getGlyphAtlas(r, s);
+        if (!atlas) return nullptr;
+
+        // measure the run (same layout as drawing char by char)
+        int lines = 1, cols = 0, maxCols = 0;
+        for (char ch : t) {
+            if (ch == '\n') { lines++; cols = 0; }
+            else maxCols = std::max(maxCols, ++cols);
+        }
+        if (maxCols == 0) return nullptr;
+        int w = maxCols * 6 * s - s, h = lines * 8 * s - s;
+
+        SDL_Texture* texture = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!texture) return nullptr;
+        SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+        // copy glyphs from the atlas into the run
+        SDL_Texture* prevTarget = SDL_GetRenderTarget(r);
+        SDL_SetRenderTarget(r, texture);
+        render::setDrawColor(r, 0, 0, 0, 0);
+        render::clear(r);
+        float x = 0, y = 0;
+        for (char ch : t) {
+            if (ch == '\n') { y += 8 * s; x = 0; }
+            else {
+                SDL_FRect src = glyphRect(ch, s);
+                SDL_FRect dst = { x, y, src.w, src.h };
+                render::texture(r, atlas, &src, &dst);
+                x += 6 * s;
+            }
+        }
+        SDL_SetRenderTarget(r, prevTarget);
+
+        // drop the least recently used run when full
+        if ((int)runCache.size() >= MAX_RUNS) {
+            auto oldest = std::min_element(runCache.begin(), runCache.end(),
+                [](const auto& a, const auto& b) { return a.second.lastUsed < b.second.lastUsed; });
+            rectBatch.destroyAfterFlush(oldest->second.texture);
+            runCache.erase(oldest);
+        }
+
+        TextRun& run = runCache[key];
+        run.texture = texture;
+        run.w = (float)w;
+        run.h = (float)h;
+        run.lastUsed = ++runClock;
+        return &run;
+    }
+
+    void drawChar(SDL_Renderer* r, float x, float y, char ch, SDL_Color c, int s) {
+        RENDER_SUBSYSTEM(TEXT);
+        SDL_Texture* atlas = getGlyphAtlas(r, s);
+        if (!atlas) { drawCharRects(x, y, ch, c, s); return; }
+        SDL_FRect src = glyphRect(ch, s);
+        SDL_FRect dst = { x, y, src.w, src.h };
+        rectBatch.texture(atlas, src, dst, tint(c));
+    }
+
+    void drawText(SDL_Renderer* r, float x, float y, const std::string& t, SDL_Color c, int s) {
+        RENDER_SUBSYSTEM(TEXT);
+        TextRun* run = getTextRun(r, t, s);
+        if (run) {
+            SDL_FRect src = { 0, 0, run->w, run->h };
+            SDL_FRect dst = { x, y, run->w, run->h };
+            rectBatch.texture(run->texture, src, dst, tint(c));
+            return;
+        }
+
+        // no run texture - draw char by char
+        float startX = x;
+        for (char ch : t) {
+            if (ch == '\n') { y += 8 * s; x = startX; }
+            else { drawChar(r, x, y, ch, c, s); x += 6 * s; }
+        }
+    }
+
+    void drawTextShadow(SDL_Renderer* r, float x, float y, const std::string& t, SDL_Color mainC, SDL_Color shadowC, int s) {
+        drawText(r, x + 2, y + 2, t, shadowC, s);
+        drawText(r, x, y, t, mainC, s);
+    }
+
+    void clearTextCache() {
+        for (auto& atlas : glyphAtlas) {
+            if (atlas) SDL_DestroyTexture(atlas);
+            atlas = nullptr;
+        }
+        for (auto& entry : runCache) SDL_DestroyTexture(entry.second.texture);
+        runCache.clear();
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <SDL3/SDL.h>
+#include <string>
+
+// custom bitmap font
+// Glyphs are baked into an atlas texture per scale, and whole strings are cached
+// as text-run textures, so a string that does not change is drawn as one quad.
+namespace ui {
+    // Draw single character at position
+    void drawChar(SDL_Renderer* r, float x, float y, char ch, SDL_Color c, int s = 2);
+
+    // Draw text string
+    void drawText(SDL_Renderer* r, float x, float y, const std::string& t, SDL_Color c, int s = 2);
+
+    // Draw text with drop shadow
+    void drawTextShadow(SDL_Renderer* r, float x, float y, const std::string& t, SDL_Color mainC, SDL_Color shadowC, int s = 2);
+
+    // Destroy glyph atlases and cached runs (call before the renderer is destroyed or after a device reset)
+    void clearTextCache();
+}
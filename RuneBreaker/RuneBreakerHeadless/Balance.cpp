@@ -0,0 +1,125 @@
+#include "Balance.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "AutoPlayer.h"
+#include "GameSim.h"
+#include "JobSystem.h"
+
+// A level not cleared within 5 minutes of play counts as stuck
+static const float LEVEL_TIME_LIMIT = 300.0f;
+static const int LEVEL_STEP_LIMIT = (int)(LEVEL_TIME_LIMIT / FIXED_DT);
+
+// What happened on one level of one game
+struct LevelRun {
+    bool cleared = false;
+    bool timedOut = false;
+    int steps = 0;
+    int livesLost = 0;
+    int pickups = 0;
+    int score = 0;
+};
+
+// Play level from a fresh game until it is cleared, the game is lost or time runs out
+static LevelRun playLevel(int level, uint64_t seed, const AutoPlayerSkill& skill) {
+    GameSim sim;
+    sim.reset(level, seed);
+    AutoPlayer player;
+    player.reset(seed, skill);
+
+    LevelRun run;
+    while (sim.status() == SimStatus::PLAYING && sim.level() == level && run.steps < LEVEL_STEP_LIMIT) {
+        sim.step(player.play(sim), FIXED_DT);
+        run.steps++;
+        for (const SimEvent& e : sim.events()) {
+            if (e.type == SimEventType::LIFE_LOST) run.livesLost++;
+            else if (e.type == SimEventType::POWERUP_COLLECTED) run.pickups++;
+        }
+    }
+    run.cleared = sim.level() != level || sim.status() == SimStatus::WON;
+    run.timedOut = !run.cleared && sim.status() == SimStatus::PLAYING;
+    run.score = sim.score();
+    return run;
+}
+
+// Mean and 10th/50th/90th percentiles of values (sorted in place)
+struct Spread {
+    float mean = 0, p10 = 0, p50 = 0, p90 = 0;
+};
+
+static Spread spread(std::vector<float>& values) {
+    Spread s;
+    if (values.empty()) return s;
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (float v : values) sum += v;
+    s.mean = (float)(sum / values.size());
+    auto at = [&](float q) { return values[std::min(values.size() - 1, (size_t)(q * values.size()))]; };
+    s.p10 = at(0.1f);
+    s.p50 = at(0.5f);
+    s.p90 = at(0.9f);
+    return s;
+}
+
+static void printSpread(const char* name, std::vector<float>& values) {
+    Spread s = spread(values);
+    std::printf("  %-16s mean %8.1f   p10 %8.1f   p50 %8.1f   p90 %8.1f\n", name, s.mean, s.p10, s.p50, s.p90);
+}
+
+void runBalance(int gamesPerLevel, uint64_t seed, const AutoPlayerSkill& skill) {
+    if (gamesPerLevel <= 0) return;
+
+    // Each level gets its own block of run seeds. Levels that share a row count and
+    // hit-point rules would otherwise build the same layouts and report the same numbers.
+    // Every game writes only its own slot, so scheduling cannot change the results.
+    std::vector<LevelRun> runs((size_t)MAX_LEVELS * gamesPerLevel);
+    auto start = std::chrono::steady_clock::now();
+    jobs.parallelFor((int)runs.size(), 1, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            runs[i] = playLevel(1 + i / gamesPerLevel, seed + i, skill);
+        }
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%d games per level, seeds %llu..%llu, %d threads, %.2f s\n", gamesPerLevel,
+        (unsigned long long)seed, (unsigned long long)(seed + runs.size() - 1), jobs.threadCount(), seconds);
+    std::printf("autoplayer reaction %.2f s, aim error %.0f px\n", skill.reactionTime, skill.aimError);
+    std::printf("clear time leaves out game overs and counts a timeout as the %.0f s limit, so it is a lower bound\n",
+        LEVEL_TIME_LIMIT);
+
+    // fold every result into one number so runs with different thread counts are easy to compare
+    uint32_t digest = 2166136261u;
+    for (const LevelRun& r : runs) {
+        for (int v : { (int)r.cleared, (int)r.timedOut, r.steps, r.livesLost, r.pickups, r.score }) digest = (digest ^ (uint32_t)v) * 16777619u;
+    }
+
+    for (int level = 1; level <= MAX_LEVELS; ++level) {
+        std::vector<float> clearTime, livesLost, pickups, score;
+        int cleared = 0, timedOut = 0;
+        size_t first = (size_t)(level - 1) * gamesPerLevel;
+        for (int g = 0; g < gamesPerLevel; ++g) {
+            const LevelRun& r = runs[first + g];
+            if (r.cleared) {
+                cleared++;
+                clearTime.push_back(r.steps * FIXED_DT);
+            }
+            else if (r.timedOut) {
+                // censored at the limit rather than left out, or the spread only describes the easy seeds
+                timedOut++;
+                clearTime.push_back(LEVEL_TIME_LIMIT);
+            }
+            livesLost.push_back((float)r.livesLost);
+            pickups.push_back((float)r.pickups);
+            score.push_back((float)r.score);
+        }
+        std::printf("level %d (seeds %llu..%llu): cleared %d, game over %d, timed out %d of %d\n", level,
+            (unsigned long long)(seed + first), (unsigned long long)(seed + first + gamesPerLevel - 1),
+            cleared, gamesPerLevel - cleared - timedOut, timedOut, gamesPerLevel);
+        printSpread("clear time (s)", clearTime);
+        printSpread("lives lost", livesLost);
+        printSpread("pickups", pickups);
+        printSpread("score", score);
+    }
+    std::printf("result digest %08x\n", digest);
+}
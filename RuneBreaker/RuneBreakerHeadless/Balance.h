@@ -0,0 +1,10 @@
+#pragma once
+#include <cstdint>
+#include "AutoPlayer.h"
+
+// Play gamesPerLevel games on every level with an autoplayer of the given
+// skill, spread over the job system, and print per-level outcome counts and
+// distributions of clear time, lives lost, power-up pickups and score. Game g on level L uses run seed
+// seed + (L - 1) * gamesPerLevel + g, and each game only touches its own
+// GameSim, so the report is the same for any number of threads.
+void runBalance(int gamesPerLevel, uint64_t seed, const AutoPlayerSkill& skill);
@@ -0,0 +1,134 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "AutoPlayer.h"
+#include "Balance.h"
+#include "GameSim.h"
+#include "JobSystem.h"
+#include "Replay.h"
+#include "Rewind.h"
+#include <vector>
+
+// Steps needed before giving up on a game that never ends (10 minutes of play)
+static const int MAX_STEPS = (int)(600.0f / FIXED_DT);
+
+// worker threads for --balance
+JobSystem jobs;
+
+// Play a replay as fast as possible, returns the process exit code
+static int playReplay(const char* path) {
+    ReplayPlayer player;
+    if (!player.load(path)) return 1;
+
+    GameSim sim;
+    auto start = std::chrono::steady_clock::now();
+    player.begin(sim);
+    while (player.step(sim)) {}
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (player.desynced()) {
+        std::printf("replay desynced at step %d of %d\n", player.desyncAt(), player.stepCount());
+        return 2;
+    }
+    std::printf("replay matched for %d steps in %.3f s, score %d on level %d\n", player.stepsPlayed(), seconds,
+        sim.score(), sim.level());
+    return 0;
+}
+
+// Push an autoplayed game through rewind buffers of several byte budgets, then rewind every
+// stored step and compare it with the state hash recorded on the way forward.
+// Returns the process exit code.
+static int checkRewind(uint64_t seed) {
+    const int STEPS = 3000;
+    const size_t budgets[] = { 3000, 10000, 20000, 8 * 1024 * 1024 };
+    int failures = 0;
+    for (size_t budget : budgets) {
+        GameSim sim;
+        sim.reset(3, seed);
+        AutoPlayer player;
+        player.reset(seed);
+        RewindBuffer rewind;
+        rewind.init((STEPS + 1) * FIXED_DT, budget);
+
+        std::vector<uint64_t> hashes;
+        rewind.push(sim);
+        hashes.push_back(sim.stateHash());
+        for (int i = 0; i < STEPS && sim.status() == SimStatus::PLAYING; ++i) {
+            sim.step(player.play(sim), FIXED_DT);
+            rewind.push(sim);
+            hashes.push_back(sim.stateHash());
+        }
+
+        int stored = rewind.stepsStored(), mismatches = 0;
+        size_t used = rewind.bytesUsed();
+        for (int k = 1; k <= stored; ++k) {
+            if (rewind.rewind(sim) != 1 || sim.stateHash() != hashes[hashes.size() - 1 - k]) {
+                if (mismatches == 0) std::printf("  budget %zu: step back %d of %d does not match\n", budget, k, stored);
+                mismatches++;
+            }
+        }
+        std::printf("budget %zu bytes: %d steps stored in %zu bytes, %d mismatches\n", budget, stored, used, mismatches);
+        if (mismatches > 0 || stored == 0) failures++;
+    }
+    return failures > 0 ? 2 : 0;
+}
+
+// Runs whole games without a window and reports how fast the simulation steps
+int main(int argc, char* argv[]) {
+    int games = 100, level = 1, threads = 0;
+    uint64_t seed = 1;
+    AutoPlayerSkill skill;
+    bool balance = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (std::strcmp(argv[i], "--balance") == 0) {
+            balance = true;
+            continue;
+        }
+        if (std::strcmp(argv[i], "--rewind-check") == 0) return checkRewind(seed);
+        if (value && std::strcmp(argv[i], "--games") == 0) games = std::atoi(value);
+        else if (value && std::strcmp(argv[i], "--level") == 0) level = std::atoi(value);
+        else if (value && std::strcmp(argv[i], "--seed") == 0) seed = std::strtoull(value, nullptr, 10);
+        else if (value && std::strcmp(argv[i], "--threads") == 0) threads = std::atoi(value);
+        else if (value && std::strcmp(argv[i], "--reaction") == 0) skill.reactionTime = (float)std::atof(value);
+        else if (value && std::strcmp(argv[i], "--aim-error") == 0) skill.aimError = (float)std::atof(value);
+        else if (value && std::strcmp(argv[i], "--replay") == 0) return playReplay(value);
+        else {
+            std::fprintf(stderr, "usage: %s [--games N] [--level L] [--seed S] [--replay FILE] [--reaction S] [--aim-error PX] [--balance [--threads N]] [--rewind-check]\n", argv[0]);
+            return 1;
+        }
+        i++;
+    }
+    if (balance) {
+        jobs.init(threads);
+        runBalance(games, seed, skill);
+        return 0;
+    }
+    if (level < 1 || level > MAX_LEVELS) level = 1;
+
+    GameSim sim;
+    AutoPlayer player;
+    long long totalSteps = 0, totalScore = 0;
+    int won = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int g = 0; g < games; ++g) {
+        sim.reset(level, seed + g);
+        player.reset(seed + g, skill);
+        int steps = 0;
+        while (sim.status() == SimStatus::PLAYING && steps < MAX_STEPS) {
+            sim.step(player.play(sim), FIXED_DT);
+            steps++;
+        }
+        totalSteps += steps;
+        totalScore += sim.score();
+        if (sim.status() == SimStatus::WON) won++;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%d games from level %d: %d won, average score %.1f\n", games, level, won,
+        games > 0 ? (double)totalScore / games : 0.0);
+    std::printf("%lld steps in %.2f s (%.0f steps/s, %.1f game-seconds per second)\n", totalSteps, seconds,
+        seconds > 0 ? totalSteps / seconds : 0.0, seconds > 0 ? totalSteps * FIXED_DT / seconds : 0.0);
+    return 0;
+}